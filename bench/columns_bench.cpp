@@ -0,0 +1,175 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+// Compares the sums of the column kernels with the sums over filter views of
+// the expenses, from 10^4 to 10^7 entries.
+
+#include <chrono>
+#include <random>
+#include <iostream>
+#include <iomanip>
+
+#include "expenses.hpp"
+#include "columns.hpp"
+#include "column_kernels.hpp"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct dataset {
+    std::vector<budget::expense> expenses;
+    std::vector<uint32_t> months;
+    std::vector<uint32_t> accounts;
+    std::vector<int64_t> amounts;
+};
+
+// Ten years of expenses on eight accounts
+dataset generate(size_t n){
+    std::mt19937_64 generator(42);
+
+    dataset data;
+    data.expenses.reserve(n);
+
+    for (size_t i = 0; i < n; ++i) {
+        budget::date date(2010 + generator() % 10, 1 + generator() % 12, 1 + generator() % 28);
+
+        budget::expense expense{i + 1, "", date, "", generator() % 8, {}};
+        expense.amount.value = generator() % 100000;
+
+        data.months.push_back(budget::column_month(expense.date.year(), expense.date.month()));
+        data.accounts.push_back(expense.account);
+        data.amounts.push_back(expense.amount.value);
+
+        data.expenses.push_back(std::move(expense));
+    }
+
+    return data;
+}
+
+// The average time of a call in microseconds, over about 200ms of calls
+// The functor is called with a different month each time, so that the
+// calls cannot be merged
+template <typename Functor>
+double measure(int64_t& checksum, Functor functor){
+    size_t calls = 0;
+    auto start   = clock_type::now();
+    auto elapsed = clock_type::duration::zero();
+
+    do {
+        checksum += functor(calls % 120);
+        ++calls;
+        elapsed = clock_type::now() - start;
+    } while (elapsed < std::chrono::milliseconds(200));
+
+    return std::chrono::duration<double, std::micro>(elapsed).count() / calls;
+}
+
+void report(size_t n, const char* predicate, const char* method, double time, double reference){
+    std::cout << std::setw(10) << n << std::setw(16) << predicate << std::setw(10) << method
+              << std::setw(14) << std::fixed << std::setprecision(1) << time
+              << std::setw(10) << std::setprecision(2) << reference / time << "x" << std::endl;
+}
+
+// Times the filter and all the supported kernels on the same predicate, after
+// checking that they compute the same sums
+template <typename Filter, typename Kernel>
+bool compare(size_t n, const char* predicate, int64_t& sink, Filter filter, Kernel kernel){
+    // One month of each year, each time a different one
+    for (size_t month = 0; month < 120; month += 13) {
+        auto expected = filter(month);
+
+        for (auto& kernels : budget::supported_column_kernels()) {
+            if (kernel(kernels, month) != expected) {
+                std::cout << "ERROR: The " << kernels.name << " kernels give a wrong sum for the " << predicate << " predicate" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    auto reference = measure(sink, filter);
+
+    report(n, predicate, "filter", reference, reference);
+
+    for (auto& kernels : budget::supported_column_kernels()) {
+        auto time = measure(sink, [&kernels, &kernel](size_t month) { return kernel(kernels, month); });
+
+        report(n, predicate, kernels.name, time, reference);
+    }
+
+    return true;
+}
+
+bool bench(size_t n){
+    auto data = generate(n);
+
+    auto& expenses      = data.expenses;
+    const uint32_t base = budget::column_month(2010, 1);
+
+    int64_t sink = 0;
+
+    // month-equals
+    auto month_filter = [&expenses](size_t month) {
+        budget::year year(2010 + month / 12);
+        budget::month m(1 + month % 12);
+
+        return budget::accumulate_amount_if(expenses, [year, m](const budget::expense& e) { return e.date.year() == year && e.date.month() == m; }).value;
+    };
+
+    auto month_kernel = [&data, base, n](const budget::column_kernels& kernels, size_t month) {
+        return kernels.sum_range(data.months.data(), data.amounts.data(), n, base + month, 0);
+    };
+
+    // account-equals, in a month
+    auto account_filter = [&expenses](size_t month) {
+        budget::year year(2010 + month / 12);
+        budget::month m(1 + month % 12);
+        size_t account = month % 8;
+
+        return budget::accumulate_amount_if(expenses, [year, m, account](const budget::expense& e) {
+            return e.account == account && e.date.year() == year && e.date.month() == m;
+        }).value;
+    };
+
+    auto account_kernel = [&data, base, n](const budget::column_kernels& kernels, size_t month) {
+        return kernels.sum_account(data.months.data(), data.accounts.data(), data.amounts.data(), n, base + month, 0, month % 8);
+    };
+
+    // date range, the twelve months from the given one
+    auto range_filter = [&expenses](size_t month) {
+        budget::date first(2010 + month / 12, 1 + month % 12, 1);
+        budget::date last = first + budget::months(12) - budget::days(1);
+
+        return budget::accumulate_amount_if(expenses, [first, last](const budget::expense& e) { return e.date >= first && e.date <= last; }).value;
+    };
+
+    auto range_kernel = [&data, base, n](const budget::column_kernels& kernels, size_t month) {
+        return kernels.sum_range(data.months.data(), data.amounts.data(), n, base + month, 11);
+    };
+
+    bool valid = compare(n, "month", sink, month_filter, month_kernel)
+              && compare(n, "account+month", sink, account_filter, account_kernel)
+              && compare(n, "date range", sink, range_filter, range_kernel);
+
+    // The sums are used, so that they are computed
+    return valid && sink != 42;
+}
+
+} // end of anonymous namespace
+
+int main(){
+    std::cout << std::setw(10) << "rows" << std::setw(16) << "predicate" << std::setw(10) << "method"
+              << std::setw(14) << "us/call" << std::setw(11) << "speedup" << std::endl;
+
+    for (size_t n : {10000, 100000, 1000000, 10000000}) {
+        if (!bench(n)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
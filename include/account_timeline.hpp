@@ -0,0 +1,50 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "date.hpp"
+
+namespace budget {
+
+/*!
+ * \brief When each named account is active, by month.
+ *
+ * An account is active in a month when it is part of all_accounts(year, month).
+ * The months are indexed as year * 12 + month - 1.
+ */
+struct account_timeline {
+    std::map<std::string, std::vector<std::pair<size_t, size_t>>> intervals; ///< The [first, last] active months of each name
+    std::vector<size_t> changes; ///< The sorted months with different names than the month before
+
+    /*!
+     * \brief Indicates if the names of the accounts change after the first month, until the last month.
+     *
+     * This is O(log(changes)).
+     */
+    bool changes_between(budget::year first_year, budget::month first_month, budget::year last_year, budget::month last_month) const;
+
+    /*!
+     * \brief Returns the sorted names of the accounts active in the month
+     */
+    std::vector<std::string> names(budget::year year, budget::month month) const;
+};
+
+/*!
+ * \brief Returns the timeline of the accounts.
+ *
+ * The timeline is computed once for each generation of the accounts.
+ */
+std::shared_ptr<const account_timeline> accounts_timeline();
+
+} //end of namespace budget
@@ -0,0 +1,104 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+#include <map>
+#include <tuple>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "date.hpp"
+#include "money.hpp"
+
+namespace budget {
+
+/*!
+ * \brief The coordinates of a cell of an aggregation cube.
+ *
+ * The name is the id of a normalized name: lower case and without its
+ * trailing space. Its displayed name is given by aggregation_cube::label.
+ */
+struct cube_key {
+    budget::date_type year;
+    budget::date_type month;
+    size_t account;
+    uint32_t name;
+
+    bool operator<(const cube_key& rhs) const {
+        return std::tie(year, month, account, name) < std::tie(rhs.year, rhs.month, rhs.account, rhs.name);
+    }
+};
+
+struct cube_cell {
+    budget::money sum;
+    size_t count = 0;
+};
+
+/*!
+ * \brief The sum and count of the amounts of a module, by (year, month, account, name).
+ *
+ * The cells are ordered by year, then by month, a year or a month is a
+ * contiguous slice of the cube.
+ */
+struct aggregation_cube {
+    std::map<cube_key, cube_cell> cells;
+    std::vector<std::string> labels; ///< The displayed name of each normalized name, by id
+
+    /*!
+     * \brief Returns the displayed name of the normalized name
+     */
+    const std::string& label(uint32_t name) const;
+
+    /*!
+     * \brief Call the functor with (key, cell) for each cell
+     */
+    template <typename Functor>
+    void for_each_cell(Functor functor) const {
+        for (auto& cell : cells) {
+            functor(cell.first, cell.second);
+        }
+    }
+
+    /*!
+     * \brief Call the functor with (key, cell) for each cell of the year
+     */
+    template <typename Functor>
+    void for_each_cell(budget::year year, Functor functor) const {
+        for_each_between({year.value, 0, 0, 0}, {date_type(year.value + 1), 0, 0, 0}, functor);
+    }
+
+    /*!
+     * \brief Call the functor with (key, cell) for each cell of the month
+     */
+    template <typename Functor>
+    void for_each_cell(budget::year year, budget::month month, Functor functor) const {
+        for_each_between({year.value, month.value, 0, 0}, {year.value, date_type(month.value + 1), 0, 0}, functor);
+    }
+
+private:
+    // The cells from first (included) to last (excluded)
+    template <typename Functor>
+    void for_each_between(const cube_key& first, const cube_key& last, Functor functor) const {
+        for (auto it = cells.lower_bound(first); it != cells.end() && it->first < last; ++it) {
+            functor(it->first, it->second);
+        }
+    }
+};
+
+/*!
+ * \brief Returns the aggregation cube of the expenses.
+ *
+ * The cube is built again once for each generation of the expenses. The
+ * overviews then read the cells of a year or of a month, instead of all the
+ * expenses.
+ */
+std::shared_ptr<const aggregation_cube> expenses_cube();
+
+} //end of namespace budget
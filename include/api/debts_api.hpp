@@ -18,5 +18,6 @@ void add_debts_api(const httplib::Request& req, httplib::Response& res);
 void edit_debts_api(const httplib::Request& req, httplib::Response& res);
 void delete_debts_api(const httplib::Request& req, httplib::Response& res);
 void list_debts_api(const httplib::Request& req, httplib::Response& res);
+void table_debts_api(const httplib::Request& req, httplib::Response& res);
 
 } //end of namespace budget
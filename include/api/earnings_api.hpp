@@ -18,5 +18,6 @@ void add_earnings_api(const httplib::Request& req, httplib::Response& res);
 void edit_earnings_api(const httplib::Request& req, httplib::Response& res);
 void delete_earnings_api(const httplib::Request& req, httplib::Response& res);
 void list_earnings_api(const httplib::Request& req, httplib::Response& res);
+void table_earnings_api(const httplib::Request& req, httplib::Response& res);
 
 } //end of namespace budget
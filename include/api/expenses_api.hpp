@@ -18,5 +18,6 @@ void add_expenses_api(const httplib::Request& req, httplib::Response& res);
 void edit_expenses_api(const httplib::Request& req, httplib::Response& res);
 void delete_expenses_api(const httplib::Request& req, httplib::Response& res);
 void list_expenses_api(const httplib::Request& req, httplib::Response& res);
+void table_expenses_api(const httplib::Request& req, httplib::Response& res);
 
 } //end of namespace budget
@@ -0,0 +1,23 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+namespace httplib {
+struct Request;
+struct Response;
+};
+
+namespace budget {
+
+// The time series accept optional start and end dates (YYYY-MM-DD), a
+// budget of points and a downsampling method (lttb or minmax)
+
+void net_worth_series_api(const httplib::Request& req, httplib::Response& res);
+void fi_ratio_series_api(const httplib::Request& req, httplib::Response& res);
+
+} //end of namespace budget
@@ -10,6 +10,8 @@
 #include <string>
 #include <vector>
 
+#include "metrics.hpp"
+
 namespace httplib {
 struct Server;
 struct Request;
@@ -19,14 +21,14 @@ struct Response;
 namespace budget {
 
 // For the server
-void load_api(httplib::Server& server);
+void load_api(budget::metered_server& server);
 
 // For the API pages
 bool api_start(const httplib::Request& req, httplib::Response& res);
 void api_error(const httplib::Request& req, httplib::Response& res, const std::string& message);
 void api_success(const httplib::Request& req, httplib::Response& res, const std::string& message);
 void api_success(const httplib::Request& req, httplib::Response& res, const std::string& message, const std::string& content);
-void api_success_content(const httplib::Request& req, httplib::Response& res, const std::string& content);
+void api_success_content(const httplib::Request& req, httplib::Response& res, const std::string& content, const char* content_type = "text/plain");
 bool parameters_present(const httplib::Request& req, std::vector<const char*> parameters);
 
 } //end of namespace budget
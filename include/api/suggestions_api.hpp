@@ -0,0 +1,21 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+namespace httplib {
+struct Request;
+struct Response;
+};
+
+namespace budget {
+
+void suggest_expenses_api(const httplib::Request& req, httplib::Response& res);
+void suggest_earnings_api(const httplib::Request& req, httplib::Response& res);
+void suggest_accounts_api(const httplib::Request& req, httplib::Response& res);
+
+} //end of namespace budget
@@ -0,0 +1,61 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <functional>
+
+#include "date.hpp"
+
+namespace httplib {
+struct Request;
+struct Response;
+};
+
+namespace budget {
+
+/*!
+ * \brief A column of a table served page by page. The rows are given by their index.
+ */
+struct table_column {
+    std::function<std::string(size_t row)> cell;      ///< The value of the cell, with the formatting of the writers
+    std::function<bool(size_t lhs, size_t rhs)> less; ///< The order of the column, empty if it cannot be sorted
+    bool searchable;                                  ///< Indicates if the search applies to this column
+
+    table_column(std::function<std::string(size_t)> cell, std::function<bool(size_t, size_t)> less = {}, bool searchable = false)
+            : cell(cell), less(less), searchable(searchable) {}
+};
+
+/*!
+ * \brief Returns the rows matching the search, in any order
+ */
+using table_search = std::function<std::vector<size_t>(const std::string& search)>;
+
+/*!
+ * \brief Write the value as a JSON string, with its quotes
+ */
+void write_json_string(std::ostream& os, const std::string& value);
+
+/*!
+ * \brief Answer a request of the server-side protocol of DataTables.
+ *
+ * The rows are filtered by the search and by the optional start_date and
+ * end_date parameters. They are then sorted on the requested column, and only
+ * the requested page of rows is rendered.
+ *
+ * \param rows The number of rows of the table
+ * \param columns The displayed columns of the table
+ * \param date The date of a row, for the range of dates, may be empty
+ * \param search The index of the table, when empty the searchable columns are scanned
+ */
+void table_api(const httplib::Request& req, httplib::Response& res, size_t rows, const std::vector<table_column>& columns,
+               const std::function<budget::date(size_t row)>& date = {}, const table_search& search = {});
+
+} //end of namespace budget
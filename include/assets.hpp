@@ -147,6 +147,16 @@ budget::money get_net_worth_cash();
 
 budget::money get_net_worth(budget::date d);
 
+/*!
+ * \brief Returns the net worth of each day from first to last, both included.
+ *
+ * The values of each asset are swept once, in order of date, instead of
+ * being searched again for each day.
+ *
+ * \param convert Indicates if the values are converted to the default currency
+ */
+std::vector<budget::money> get_net_worth_series(budget::date first, budget::date last, bool convert = true);
+
 // The value of an assert in its own currency
 budget::money get_asset_value(budget::asset & asset);
 budget::money get_asset_value(budget::asset & asset, budget::date d);
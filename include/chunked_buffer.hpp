@@ -0,0 +1,105 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+
+namespace budget {
+
+/*!
+ * \brief A stream buffer writing into a list of chunks.
+ *
+ * The chunks are never reallocated when the buffer grows, the characters are
+ * written directly into them. Placeholders can be registered, they are then
+ * replaced while the text is written.
+ *
+ * When a sink is set, the buffer does not grow: its content is given to the
+ * sink when the stream is flushed or when its chunk is full.
+ */
+struct chunked_buffer : std::streambuf {
+    using sink_type = std::function<void(const char* data, size_t size)>;
+
+    chunked_buffer();
+
+    chunked_buffer(const chunked_buffer& rhs) = delete;
+    chunked_buffer& operator=(const chunked_buffer& rhs) = delete;
+
+    /*!
+     * \brief Replace each later occurrence of the placeholder with the given value.
+     *
+     * The placeholders must start with "__" and be written in a single write.
+     */
+    void add_placeholder(const std::string& placeholder, const std::string& value);
+
+    /*!
+     * \brief Use the same placeholders as the given buffer
+     */
+    void copy_placeholders(const chunked_buffer& rhs);
+
+    /*!
+     * \brief Send the content of the buffer to the given sink, from now on
+     */
+    void set_sink(sink_type sink);
+
+    /*!
+     * \brief Returns the number of characters written in the buffer
+     */
+    size_t size() const;
+
+    /*!
+     * \brief Move the content of the buffer into the given string and clear the buffer.
+     *
+     * When everything fits in the first chunk, no copy is made.
+     */
+    void move_into(std::string& result);
+
+    /*!
+     * \brief Call the functor with (data, size) for each chunk, in order
+     */
+    template <typename Functor>
+    void for_each_chunk(Functor functor) const {
+        for (size_t i = 0; i + 1 < chunks.size(); ++i) {
+            functor(chunks[i].data(), chunks[i].size());
+        }
+
+        functor(pbase(), static_cast<size_t>(pptr() - pbase()));
+    }
+
+protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char* s, std::streamsize n) override;
+    int sync() override;
+
+private:
+    std::vector<std::string> chunks;
+    size_t full_size = 0; ///< The number of characters in all the chunks but the last
+    std::vector<std::pair<std::string, std::string>> placeholders;
+    sink_type sink;
+
+    void next_chunk();
+    void flush_sink();
+    void write_raw(const char* s, size_t n);
+};
+
+/*!
+ * \brief An output stream writing into a chunked_buffer
+ */
+struct chunked_stream : std::ostream {
+    chunked_buffer buffer;
+
+    chunked_stream() : std::ostream(nullptr) {
+        rdbuf(&buffer);
+    }
+};
+
+} //end of namespace budget
@@ -0,0 +1,49 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace budget {
+
+/*!
+ * \brief Sums of the amounts of the entries whose key is in a range, over the columns.
+ *
+ * An entry is selected when key - first <= width, as unsigned integers, which
+ * tests both bounds of the range at once. There is one implementation for
+ * each set of instructions.
+ */
+struct column_kernels {
+    const char* name; ///< "avx2", "sse4.1" or "scalar"
+
+    /*!
+     * \brief Sum the amounts whose key is in [first, first + width]
+     */
+    int64_t (*sum_range)(const uint32_t* keys, const int64_t* amounts, size_t n, uint32_t first, uint32_t width);
+
+    /*!
+     * \brief Sum the amounts whose key is in [first, first + width] and whose account is the target
+     */
+    int64_t (*sum_account)(const uint32_t* keys, const uint32_t* accounts, const int64_t* amounts, size_t n, uint32_t first, uint32_t width, uint32_t target);
+};
+
+/*!
+ * \brief Returns the kernels supported by the processor, the fastest first.
+ *
+ * The scalar kernels are always supported, they are the last ones.
+ */
+const std::vector<column_kernels>& supported_column_kernels();
+
+/*!
+ * \brief Returns the fastest kernels supported by the processor, chosen once at runtime
+ */
+const column_kernels& best_column_kernels();
+
+} //end of namespace budget
@@ -0,0 +1,79 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "date.hpp"
+#include "money.hpp"
+
+namespace budget {
+
+/*!
+ * \brief The entries of a module, stored column by column.
+ *
+ * The i-th value of each column is the i-th entry of the module. The
+ * aggregations read only the columns they need, in contiguous arrays.
+ */
+struct data_columns {
+    std::vector<uint32_t> months;   ///< The month of each entry, as year * 12 + month - 1
+    std::vector<uint32_t> accounts; ///< The account of each entry
+    std::vector<int64_t> amounts;   ///< The amount of each entry, in the unit of money::value
+    std::vector<uint32_t> names;    ///< The name of each entry, as an index in name_table
+
+    std::vector<std::string> name_table; ///< The distinct names
+
+    size_t size() const {
+        return amounts.size();
+    }
+};
+
+/*!
+ * \brief Returns the month index of the given month, as used in the columns
+ */
+inline uint32_t column_month(budget::year year, budget::month month){
+    return uint32_t(year) * 12 + (month - 1);
+}
+
+/*!
+ * \brief Returns the columns of the expenses.
+ *
+ * The columns are rebuilt once for each generation of the expenses, so they
+ * are always in sync with all_expenses().
+ */
+std::shared_ptr<const data_columns> expenses_columns();
+
+/*!
+ * \brief Returns the columns of the earnings.
+ *
+ * The columns are rebuilt once for each generation of the earnings, so they
+ * are always in sync with all_earnings().
+ */
+std::shared_ptr<const data_columns> earnings_columns();
+
+/*!
+ * \brief Returns the sum of the amounts of the entries from the first month to the last month, both included
+ */
+budget::money sum_amounts(const data_columns& columns, uint32_t first_month, uint32_t last_month);
+
+/*!
+ * \brief Returns the sum of the amounts of the entries of the account from the first month to the last month, both included
+ */
+budget::money sum_amounts(const data_columns& columns, size_t account, uint32_t first_month, uint32_t last_month);
+
+/*!
+ * \brief Add the amount of each entry to the bucket of its month, from the first month.
+ *
+ * The entries after the last bucket are ignored.
+ */
+void bucket_amounts(const data_columns& columns, uint32_t first_month, std::vector<budget::money>& buckets);
+
+} //end of namespace budget
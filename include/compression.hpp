@@ -0,0 +1,38 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+#include <string>
+
+namespace budget {
+
+/*!
+ * \brief Responses smaller than this are not worth compressing
+ */
+constexpr const size_t compression_threshold = 1024;
+
+/*!
+ * \brief Select the content encoding to use for a response.
+ * \param accept_encoding The value of the Accept-Encoding header of the request
+ * \return "gzip", "deflate" or an empty string if the response must not be compressed
+ */
+std::string negotiate_encoding(const std::string& accept_encoding);
+
+/*!
+ * \brief Compress the data with the given encoding ("gzip" or "deflate").
+ * \return The compressed data or an empty string if the data could not be compressed
+ */
+std::string compress(const std::string& data, const std::string& encoding);
+
+/*!
+ * \brief Decompress data encoded with gzip or deflate.
+ * \return true if the data could be decompressed, false otherwise
+ */
+bool decompress(const std::string& data, std::string& result);
+
+} //end of namespace budget
@@ -39,6 +39,9 @@ struct status {
     }
 };
 
+// The year and month statuses are memoized, each of them is computed once
+// until the expenses, earnings, accounts or incomes are changed
+
 status compute_year_status();
 status compute_year_status(budget::year year);
 status compute_year_status(budget::year year, budget::month last);
@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
 namespace budget {
 
 const size_t DATA_VERSION = 5;
@@ -33,6 +36,14 @@ std::string get_web_password();
 std::string get_server_listen();
 size_t get_server_port();
 
+/*!
+ * \brief Returns the pages the server pre-renders in the background.
+ *
+ * They are configured with server_hot_pages, a comma-separated list of
+ * paths. By default, only the dashboard is pre-rendered.
+ */
+std::vector<std::string> get_server_hot_pages();
+
 /*!
  * \brief Indicates if the server is running in secure mode.
  *
@@ -10,6 +10,7 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <functional>
 
 #include "money.hpp"
 #include "date.hpp"
@@ -113,10 +114,16 @@ bool check(const T& value, CheckerA first, Checker... checkers){
     return check(value, checkers...);
 }
 
+/*!
+ * \brief Returns the choices starting with the given prefix, the best first
+ */
+using string_completer = std::function<std::vector<std::string>(const std::string& prefix)>;
+
 std::string get_string_complete(const std::vector<std::string>& choices);
+std::string get_string_complete(const string_completer& completer);
 
-template<typename ...Checker>
-void edit_string_complete(std::string& ref, const std::string& title, const std::vector<std::string>& choices, Checker... checkers){
+template<typename Choices, typename ...Checker>
+void edit_string_complete_impl(std::string& ref, const std::string& title, const Choices& choices, Checker... checkers){
     bool checked;
     do {
         std::cout << title << " [" << ref << "]: ";
@@ -131,6 +138,16 @@ void edit_string_complete(std::string& ref, const std::string& title, const std:
     } while(!checked);
 }
 
+template<typename ...Checker>
+void edit_string_complete(std::string& ref, const std::string& title, const std::vector<std::string>& choices, Checker... checkers){
+    edit_string_complete_impl(ref, title, choices, checkers...);
+}
+
+template<typename ...Checker>
+void edit_string_complete(std::string& ref, const std::string& title, const string_completer& completer, Checker... checkers){
+    edit_string_complete_impl(ref, title, completer, checkers...);
+}
+
 template<typename ...Checker>
 void edit_string(std::string& ref, const std::string& title, Checker... checkers){
     bool checked;
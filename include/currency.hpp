@@ -22,4 +22,9 @@ void load_currency_cache();
 void save_currency_cache();
 void refresh_currency_cache();
 
+/*!
+ * \brief Register the refresh and compaction jobs of the currency cache
+ */
+void schedule_currency_jobs();
+
 } //end of namespace budget
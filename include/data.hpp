@@ -7,21 +7,97 @@
 
 #pragma once
 
+#include <mutex>
+#include <atomic>
+
 #include "cpp_utils/assert.hpp"
 
 #include "config.hpp"
 #include "utils.hpp"
 #include "server.hpp"
 #include "api.hpp"
+#include "metrics.hpp"
 
 namespace budget {
 
+/*!
+ * \brief Returns the generation counter of the given module.
+ *
+ * The generation of a module is increased each time its data changes, it
+ * can be used to know when results computed from the data are stale.
+ */
+std::atomic<size_t>& module_generation(const std::string& module);
+
+/*!
+ * \brief Increase the generation of the given module.
+ */
+void bump_generation(const std::string& module);
+
+/*!
+ * \brief Indicates that the data of a module changed.
+ *
+ * In server mode, the hot pages are rendered again once the data is stable.
+ */
+void data_changed();
+
+/*!
+ * \brief A value derived from the data of a module.
+ *
+ * The value is updated on the first access after a change of the generation
+ * of the module, so it is never stale and never updated when nothing changed.
+ */
+template <typename T>
+struct generation_cache {
+    explicit generation_cache(const char* module) : current(module_generation(module)) {
+        // Nothing else to init
+    }
+
+    generation_cache(const generation_cache& rhs) = delete;
+    generation_cache& operator=(const generation_cache& rhs) = delete;
+
+    /*!
+     * \brief Call update(value) if the data changed since the last update,
+     * then return use(value). Both are called under the lock of the cache.
+     */
+    template <typename Update, typename Use>
+    auto access(Update update, Use use) {
+        // The generation is read first, a change during the update is seen by the next access
+        auto generation = current.load();
+
+        std::lock_guard<std::mutex> l(lock);
+
+        if (!updated || updated_generation != generation) {
+            update(value);
+
+            updated            = true;
+            updated_generation = generation;
+        }
+
+        return use(value);
+    }
+
+    /*!
+     * \brief Returns the value, computed again with compute() if the data changed
+     */
+    template <typename Compute>
+    T get(Compute compute) {
+        return access([&compute](T& value) { value = compute(); }, [](T& value) { return value; });
+    }
+
+private:
+    std::atomic<size_t>& current;
+    std::mutex lock;
+    bool updated              = false;
+    size_t updated_generation = 0;
+    T value;
+};
+
 template<typename T>
 struct data_handler {
     size_t next_id;
     std::vector<T> data;
 
-    data_handler(const char* module, const char* path) : module(module), path(path) {
+    data_handler(const char* module, const char* path) : module(module), path(path), generation(module_generation(module)) {
         // Nothing else to init
     };
 
@@ -33,7 +109,14 @@ struct data_handler {
         return changed;
     }
 
+    size_t get_generation() const {
+        return generation;
+    }
+
     void set_changed() {
+        ++generation;
+        data_changed();
+
         if (is_server_running()) {
             force_save();
         } else {
@@ -99,6 +182,8 @@ struct data_handler {
                 }
             }
         }
+
+        ++generation;
     }
 
     void load(){
@@ -125,6 +210,8 @@ struct data_handler {
         }
 
         changed = false;
+
+        increment_counter("budget_data_saves_total", metric_label("module", module));
     }
 
     void save() {
@@ -144,6 +231,8 @@ struct data_handler {
 
     bool edit(T& value){
         if(is_server_mode()){
+            ++generation;
+
             auto params = value.get_params();
 
             auto res = budget::api_post(std::string("/") + get_module() + "/edit/", params);
@@ -176,6 +265,8 @@ struct data_handler {
                 entry.id = budget::to_number<size_t>(res.result);
 
                 data.push_back(std::forward<T>(entry));
+
+                ++generation;
             }
         } else {
             entry.id = next_id++;
@@ -194,6 +285,8 @@ struct data_handler {
                    data.end());
 
         if (is_server_mode()) {
+            ++generation;
+
             std::map<std::string, std::string> params;
 
             params["input_id"] = budget::to_string(id);
@@ -256,6 +349,7 @@ private:
     const char* module;
     const char* path;
     bool changed = false;
+    std::atomic<size_t>& generation;
 };
 
 } //end of namespace budget
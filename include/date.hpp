@@ -401,6 +401,16 @@ date from_iso_string(const std::string& str);
 
 std::string date_to_string(date date);
 
+/*!
+ * \brief Returns the number of days between 1970-01-01 and the given date.
+ */
+long day_number(budget::date date);
+
+/*!
+ * \brief Returns the date corresponding to the given day number.
+ */
+budget::date from_day_number(long day_number);
+
 template<>
 inline std::string to_string(budget::date date){
     return date_to_string(date);
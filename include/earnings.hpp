@@ -59,6 +59,12 @@ void earning_delete(size_t id);
 earning& earning_get(size_t id);
 
 void show_all_earnings(budget::writer& w);
+
+/*!
+ * \brief Display the earnings matching the search, at most limit of them, all of them if limit is zero
+ */
+void search_earnings(const std::string& search, size_t limit, budget::writer& w);
+
 void show_earnings(budget::month month, budget::year year, budget::writer& w);
 void show_earnings(budget::month month, budget::writer& w);
 void show_earnings(budget::writer& w);
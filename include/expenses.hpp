@@ -65,7 +65,12 @@ void show_all_expenses(budget::writer& w);
 void show_expenses(budget::month month, budget::year year, budget::writer& w);
 void show_expenses(budget::month month, budget::writer& w);
 void show_expenses(budget::writer& w);
-void search_expenses(const std::string& search, budget::writer& w);
+
+/*!
+ * \brief Display the expenses matching the search, at most limit of them, all of them if limit is zero
+ */
+void search_expenses(const std::string& search, size_t limit, budget::writer& w);
+
 
 // Filter functions
 
@@ -0,0 +1,55 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <cstdint>
+
+#include "date.hpp"
+
+namespace budget {
+
+/*!
+ * \brief The dates covered by the entries of a module.
+ *
+ * The templates of the recurring entries are not part of the extent.
+ */
+struct data_extent {
+    bool empty = true;
+    budget::date first; ///< The first date with an entry, when not empty
+    budget::date last;  ///< The last date with an entry, when not empty
+
+    std::map<budget::date_type, uint16_t> months; ///< The active years, with the mask of their active months
+
+    bool has_year(budget::year year) const;
+    bool has_month(budget::year year, budget::month month) const;
+
+    /*!
+     * \brief Returns the first active month of the year, or 12 if the year is not active
+     */
+    budget::month first_month(budget::year year) const;
+};
+
+/*!
+ * \brief Returns the extent of the expenses.
+ *
+ * The extent is computed once for each generation of the expenses, all the
+ * later calls are O(1).
+ */
+std::shared_ptr<const data_extent> expenses_extent();
+
+/*!
+ * \brief Returns the extent of the earnings.
+ *
+ * The extent is computed once for each generation of the earnings, all the
+ * later calls are O(1).
+ */
+std::shared_ptr<const data_extent> earnings_extent();
+
+} //end of namespace budget
@@ -0,0 +1,127 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <chrono>
+#include <functional>
+
+namespace httplib {
+struct Response;
+struct Request;
+struct Server;
+};
+
+namespace budget {
+
+/*!
+ * \brief Returns the label with the given name and value, in the Prometheus format.
+ *
+ * Several labels are separated by a comma.
+ */
+std::string metric_label(const std::string& name, const std::string& value);
+
+/*!
+ * \brief Increase the counter with the given name and labels
+ */
+void increment_counter(const std::string& name, const std::string& labels = "", size_t value = 1);
+
+/*!
+ * \brief A counter registered once, which can then be increased without any lock
+ */
+struct counter {
+    std::atomic<size_t> value{0};
+
+    void increment(size_t delta = 1){
+        value.fetch_add(delta, std::memory_order_relaxed);
+    }
+};
+
+/*!
+ * \brief Returns the counter with the given name and labels, to be kept by the caller.
+ *
+ * Its value is exported with the counters of increment_counter.
+ */
+counter& register_counter(const std::string& name, const std::string& labels = "");
+
+/*!
+ * \brief Add the (possibly negative) delta to the gauge with the given name and labels
+ */
+void add_to_gauge(const std::string& name, const std::string& labels, long delta);
+
+/*!
+ * \brief Add a duration, in seconds, to the histogram with the given name and labels
+ */
+void observe_duration(const std::string& name, const std::string& labels, double seconds);
+
+/*!
+ * \brief Add a size, in bytes, to the histogram with the given name and labels
+ */
+void observe_size(const std::string& name, const std::string& labels, size_t bytes);
+
+/*!
+ * \brief Observe the duration of its scope into a duration histogram
+ */
+struct scoped_duration {
+    scoped_duration(std::string name, std::string labels);
+    ~scoped_duration();
+
+    scoped_duration(const scoped_duration& rhs) = delete;
+    scoped_duration& operator=(const scoped_duration& rhs) = delete;
+
+private:
+    std::string name;
+    std::string labels;
+    std::chrono::steady_clock::time_point start;
+};
+
+/*!
+ * \brief Returns all the metrics in the Prometheus text format.
+ *
+ * The histograms are completed with estimations of their 0.5, 0.95 and 0.99
+ * quantiles, in a gauge named after the histogram with a _quantile suffix.
+ */
+std::string metrics_text();
+
+using route_handler = std::function<void(const httplib::Request&, httplib::Response&)>;
+
+/*!
+ * \brief Registers the routes of the server with metrics.
+ *
+ * The number of requests, their latency and their response size are
+ * recorded per route, as well as the number of requests being handled.
+ * The requests are completed by finish_request, which must be installed
+ * as the logger of the server.
+ */
+struct metered_server {
+    explicit metered_server(httplib::Server& server);
+
+    metered_server& Get(const char* pattern, route_handler handler);
+    metered_server& Post(const char* pattern, route_handler handler);
+
+    /*!
+     * \brief Set the error handler of the server, without metrics
+     */
+    void set_error_handler(route_handler handler);
+
+private:
+    httplib::Server& server;
+};
+
+/*!
+ * \brief Record the metrics of the request, once its response has been written
+ */
+void finish_request(const httplib::Request& req, const httplib::Response& res);
+
+/*!
+ * \brief Count bytes of a streamed response of the current request
+ */
+void record_streamed_bytes(size_t bytes);
+
+} //end of namespace budget
@@ -0,0 +1,145 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+#include "date.hpp"
+#include "money.hpp"
+#include "compute.hpp"
+
+namespace budget {
+
+/*!
+ * \brief A dense series with one value per month, from a first month to a
+ * last month, both included.
+ */
+template <typename T>
+struct monthly_series {
+    monthly_series() = default;
+
+    monthly_series(budget::date first, budget::date last) : first_index(month_index(first)) {
+        auto last_index = month_index(last);
+
+        if (last_index >= first_index) {
+            values.resize(last_index - first_index + 1);
+        }
+    }
+
+    size_t size() const {
+        return values.size();
+    }
+
+    /*!
+     * \brief Returns the first day of the i-th month of the series
+     */
+    budget::date month_date(size_t i) const {
+        auto index = first_index + i;
+        return {budget::date_type(index / 12), budget::date_type(index % 12 + 1), 1};
+    }
+
+    bool contains(budget::date d) const {
+        auto index = month_index(d);
+        return index >= first_index && index < first_index + values.size();
+    }
+
+    /*!
+     * \brief Returns the position of the month of the given date in the series
+     */
+    size_t position(budget::date d) const {
+        return month_index(d) - first_index;
+    }
+
+    /*!
+     * \brief Add the value to the month of the given date, if it is part of the series
+     */
+    void add(budget::date d, const T& value) {
+        if (contains(d)) {
+            values[position(d)] += value;
+        }
+    }
+
+    T& operator[](size_t i) {
+        return values[i];
+    }
+
+    const T& operator[](size_t i) const {
+        return values[i];
+    }
+
+private:
+    size_t first_index = 0;
+    std::vector<T> values;
+
+    static size_t month_index(budget::date d) {
+        return d.year() * 12 + (d.month() - 1);
+    }
+};
+
+/*!
+ * \brief Returns the average of each month and the window - 1 months before it.
+ *
+ * At the beginning of the series, the average is over the available months.
+ * The sum of the window is updated incrementally.
+ */
+template <typename T>
+monthly_series<T> rolling_average(const monthly_series<T>& series, size_t window) {
+    auto average = series;
+
+    T sum{};
+
+    for (size_t i = 0; i < series.size(); ++i) {
+        sum += series[i];
+
+        if (i >= window) {
+            sum -= series[i - window];
+        }
+
+        average[i] = sum / int(std::min(i + 1, window));
+    }
+
+    return average;
+}
+
+/*!
+ * \brief Returns the first day of the first month with expenses or earnings.
+ *
+ * The over-time series go from this month to the current month.
+ */
+budget::date history_start();
+
+// Each of these is computed in a single pass over its module
+
+monthly_series<budget::money> monthly_expenses(budget::date first, budget::date last);
+monthly_series<budget::money> monthly_earnings(budget::date first, budget::date last);
+
+/*!
+ * \brief Returns the sum of the amounts of the accounts active in each month
+ */
+monthly_series<budget::money> monthly_budget(budget::date first, budget::date last);
+
+monthly_series<budget::money> monthly_base_income(budget::date first, budget::date last);
+
+/*!
+ * \brief Returns the expenses of each month, by account
+ */
+std::unordered_map<size_t, monthly_series<budget::money>> monthly_expenses_by_account(budget::date first, budget::date last);
+
+/*!
+ * \brief Returns the earnings of each month, by account
+ */
+std::unordered_map<size_t, monthly_series<budget::money>> monthly_earnings_by_account(budget::date first, budget::date last);
+
+/*!
+ * \brief Returns the status of each month, the same as compute_month_status
+ */
+monthly_series<budget::status> monthly_status(budget::date first, budget::date last);
+
+} //end of namespace budget
@@ -0,0 +1,88 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace httplib {
+struct Response;
+struct Request;
+};
+
+namespace budget {
+
+using page_handler = std::function<void(const httplib::Request&, httplib::Response&)>;
+
+/*!
+ * \brief Wrap a page so that its rendered response is cached.
+ *
+ * The response is reused until the generation of one of the given modules
+ * (or of the configuration) changes, or until the day changes. The
+ * responses carry an ETag, so that browsers can revalidate with
+ * If-None-Match and get a 304 without any rendering.
+ *
+ * \param handler The page to cache
+ * \param modules The modules the page depends on
+ */
+page_handler cached_page(page_handler handler, const std::vector<std::string>& modules);
+
+/*!
+ * \brief Wrap a page so that its rendered response is cached and can be
+ * pre-rendered by the server, when its path is configured as a hot page.
+ *
+ * \param path The path of the page, without parameters
+ * \param handler The page to cache
+ * \param modules The modules the page depends on
+ */
+page_handler hot_page(const std::string& path, page_handler handler, const std::vector<std::string>& modules);
+
+/*!
+ * \brief Render the hot pages whose cached response is not up to date.
+ */
+void prerender_hot_pages();
+
+/*!
+ * \brief Render the hot pages whose cached response is not up to date, without logging.
+ */
+void refresh_hot_pages();
+
+/*!
+ * \brief Refresh the hot pages once the data has not changed for a few seconds.
+ */
+void schedule_hot_pages_refresh();
+
+/*!
+ * \brief Refresh the hot pages at each change of day.
+ */
+void schedule_hot_pages_rollover();
+
+/*!
+ * \brief Indicates if the current thread is pre-rendering a page.
+ *
+ * A pre-rendered page is rendered without a client: it is not authenticated
+ * and it must not be streamed.
+ */
+bool is_prerendering();
+
+/*!
+ * \brief Receives the complete body of a streamed page, with its content type
+ */
+using page_capture = std::function<void(std::string&& body, const std::string& content_type)>;
+
+/*!
+ * \brief Take the capture of the page being rendered by the current thread.
+ *
+ * A page that streams its response is rendered after its handler returned.
+ * It must give its complete body to the capture, when there is one, for the
+ * page to be cached.
+ */
+page_capture take_page_capture();
+
+} //end of namespace budget
@@ -9,8 +9,11 @@
 
 #include <string>
 #include <vector>
+#include <functional>
 
 #include "date.hpp"
+#include "chunked_buffer.hpp"
+#include "metrics.hpp"
 
 namespace httplib {
 struct Server;
@@ -23,17 +26,61 @@ namespace budget {
 struct writer;
 struct html_writer;
 
-void load_pages(httplib::Server& server);
+void load_pages(budget::metered_server& server);
 
-bool page_start(const httplib::Request& req, httplib::Response& res, std::stringstream& content_stream, const std::string& title);
+/*!
+ * \brief Check the credentials of the request, in secure mode.
+ * \return true if the request can be served, false otherwise (the response is then a 401)
+ */
+bool authenticate(const httplib::Request& req, httplib::Response& res);
+
+bool page_start(const httplib::Request& req, httplib::Response& res, budget::chunked_stream& content_stream, const std::string& title);
 bool page_get_start(const httplib::Request& req, httplib::Response& res,
-                    std::stringstream& content_stream, const std::string& title, std::vector<const char*> parameters);
+                    budget::chunked_stream& content_stream, const std::string& title, std::vector<const char*> parameters);
 void page_end(budget::html_writer& w, const httplib::Request& req, httplib::Response& res);
 
+/*!
+ * \brief Stream a page with chunked transfer encoding.
+ *
+ * The page is rendered while the response is sent: the header and the
+ * navigation are sent first, then the content each time it is flushed with
+ * flush_page, and the remainder at the end.
+ *
+ * \param content Writes the content of the page
+ */
+void stream_page(const httplib::Request& req, httplib::Response& res, const std::string& title, std::function<void(budget::html_writer& w)> content);
+
+/*!
+ * \brief Send the content written so far, when the page is streamed
+ */
+void flush_page(budget::html_writer& w);
+
+/*!
+ * \brief Render independent cards of a page concurrently.
+ *
+ * Each card is written into its own buffer on the task pool. The cards are
+ * then appended to the page in order, each one being flushed as soon as it
+ * and the cards before it are done.
+ *
+ * The cards must only read the data and must not depend on each other.
+ */
+void render_cards(budget::html_writer& w, const std::vector<std::function<void(budget::html_writer& w)>>& cards);
+
 void display_error_message(budget::writer& w, const std::string& message);
 
 void make_tables_sortable(budget::html_writer& w);
 
+/*!
+ * \brief Display a table whose rows are loaded page by page from the given API.
+ *
+ * The paging, the sorting and the search are done by the server, see
+ * table_api. The rows are initially sorted on the given column, descending.
+ *
+ * \param dates Indicates if the table can be restricted to a range of dates
+ */
+void server_side_table(budget::html_writer& w, const std::string& id, const std::string& url, const std::vector<std::string>& columns,
+                       size_t order_column, bool dates);
+
 // Forms
 void form_begin(budget::writer& w, const std::string& action, const std::string& back_page);
 void page_form_begin(budget::writer& w, const std::string& action);
@@ -42,6 +89,11 @@ void form_end(budget::writer& w, const std::string& button = "");
 
 void add_text_picker(budget::writer& w, const std::string& title, const std::string& name, const std::string& default_value);
 void add_name_picker(budget::writer& w, const std::string& default_value = "");
+
+/*!
+ * \brief Add a name picker completed with the names suggested by the given API
+ */
+void add_suggested_name_picker(budget::html_writer& w, const std::string& url, const std::string& default_value = "");
 void add_title_picker(budget::writer& w, const std::string& default_value = "");
 void add_amount_picker(budget::writer& w, const std::string& default_value = "");
 void add_paid_amount_picker(budget::writer& w, const std::string& default_value = "");
@@ -56,6 +108,11 @@ void add_money_picker(budget::writer& w, const std::string& title, const std::st
 void add_integer_picker(budget::writer& w, const std::string& title, const std::string& name,
                         const std::string& default_value = "");
 
+/*!
+ * \brief Returns the limit of results of a search form, from its input_limit parameter
+ */
+size_t get_search_limit(const httplib::Request& req);
+
 // Charts
 std::stringstream start_chart_base(budget::html_writer& w, const std::string& chart_type, 
                                    const std::string& id = "container", std::string style = "");
@@ -65,4 +122,18 @@ std::stringstream start_time_chart(budget::html_writer& w, const std::string& ti
                                    const std::string& id = "container", std::string style = "");
 void end_chart(budget::html_writer& w, std::stringstream& ss);
 
+/*!
+ * \brief Returns the javascript value of a date for the time charts
+ */
+std::string chart_date(budget::date date);
+
+/*!
+ * \brief End a chart whose series are loaded from JSON endpoints.
+ *
+ * The chart must declare its series with empty data. Once the page is
+ * loaded, the data of each series is fetched from its URL, in order, with a
+ * budget of points depending on the width of the chart.
+ */
+void end_async_chart(budget::html_writer& w, std::stringstream& ss, const std::vector<std::string>& urls);
+
 } //end of namespace budget
@@ -54,6 +54,11 @@ month last_month(const recurring& recurring, budget::year year);
 
 void check_for_recurrings();
 
+/*!
+ * \brief Register the jobs of the recurring module with the scheduler
+ */
+void schedule_recurring_jobs();
+
 void load_recurrings();
 void save_recurrings();
 
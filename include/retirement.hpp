@@ -28,6 +28,14 @@ struct module_traits<retirement_module> {
 };
 
 float fi_ratio(budget::date d);
+
+/*!
+ * \brief Returns the FI ratio of each day from first to last, both included.
+ *
+ * The running expenses are computed once per month, with a sliding window,
+ * and joined with the net worth series.
+ */
+std::vector<float> fi_ratio_series(budget::date first, budget::date last);
 void retirement_status(budget::writer& w);
 
 } //end of namespace budget
@@ -0,0 +1,71 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+
+namespace budget {
+
+/*!
+ * \brief Statistics of a job of the scheduler
+ */
+struct job_metrics {
+    std::string name;
+    std::chrono::seconds period;
+    size_t runs     = 0; ///< The number of completed runs
+    size_t failures = 0; ///< The number of runs that have thrown
+    size_t overruns = 0; ///< The number of runs skipped because the previous one was not finished
+    std::chrono::milliseconds last_latency{0};
+    std::chrono::milliseconds max_latency{0};
+    std::chrono::milliseconds total_latency{0};
+};
+
+/*!
+ * \brief Register a recurring job with the scheduler.
+ *
+ * The job first runs after the given delay and then every period, plus a
+ * random jitter of up to the given value. A job never runs concurrently with
+ * itself: when it is still running at its next time, that run is skipped.
+ *
+ * \param name The name of the job, for the logs and the metrics
+ * \param period The time between two runs of the job
+ * \param job The function to run
+ * \param delay The time before the first run
+ * \param jitter The maximum random delay added to each run
+ */
+void schedule_job(const std::string& name, std::chrono::seconds period, std::function<void()> job,
+                  std::chrono::seconds delay = std::chrono::seconds(0), std::chrono::seconds jitter = std::chrono::seconds(0));
+
+/*!
+ * \brief Run a job once, after the given delay.
+ *
+ * When the job of the same name has not run yet, it is delayed again
+ * instead: the changes that come together cause a single run.
+ *
+ * \param name The name of the job, for the logs and the metrics
+ * \param delay The time before the run
+ * \param job The function to run, only the first one given for a name is used
+ */
+void schedule_once(const std::string& name, std::chrono::seconds delay, std::function<void()> job);
+
+/*!
+ * \brief Start the scheduler thread and its pool of workers
+ */
+void start_scheduler(size_t workers = 2);
+
+/*!
+ * \brief Stop the scheduler, waiting for the running jobs to finish
+ */
+void stop_scheduler();
+
+std::vector<job_metrics> scheduler_metrics();
+
+} //end of namespace budget
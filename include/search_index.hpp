@@ -0,0 +1,39 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace budget {
+
+/*!
+ * \brief The number of results displayed by default by the searches
+ */
+constexpr const size_t default_search_limit = 100;
+
+/*!
+ * \brief Returns the positions, in all_expenses(), of the expenses matching the query.
+ *
+ * The query is split into terms on the spaces and an expense matches when its
+ * name contains all the terms, regardless of the case. The exact names come
+ * first, then the names starting with the query, then the names with a word
+ * starting with a term, the most recent first in each rank.
+ *
+ * At most limit results are returned, all of them when limit is zero.
+ */
+std::vector<size_t> search_expenses_index(const std::string& query, size_t limit = 0);
+
+/*!
+ * \brief Returns the positions, in all_earnings(), of the earnings matching the query.
+ *
+ * The query is handled the same as by search_expenses_index.
+ */
+std::vector<size_t> search_earnings_index(const std::string& query, size_t limit = 0);
+
+} //end of namespace budget
@@ -0,0 +1,44 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace budget {
+
+/*!
+ * \brief A point of a time series
+ */
+struct series_point {
+    int64_t x; ///< The time, in milliseconds since 1970-01-01 UTC
+    double y;
+};
+
+/*!
+ * \brief Downsample the series with Largest-Triangle-Three-Buckets.
+ *
+ * The result keeps the first and last points and the visual shape of the
+ * series, with at most the given number of points.
+ */
+std::vector<series_point> downsample_lttb(const std::vector<series_point>& points, size_t threshold);
+
+/*!
+ * \brief Downsample the series by keeping the minimum and maximum of each bucket.
+ *
+ * Unlike LTTB, the extremes of the series are always preserved.
+ */
+std::vector<series_point> downsample_min_max(const std::vector<series_point>& points, size_t threshold);
+
+/*!
+ * \brief Write the series as a JSON array of [x, y] pairs
+ */
+std::string series_to_json(const std::vector<series_point>& points);
+
+} //end of namespace budget
@@ -16,8 +16,19 @@ struct date;
 double share_price(const std::string& quote);
 double share_price(const std::string& quote, budget::date d);
 
+/*!
+ * \brief Fetch, in a single request, all the closing prices of the
+ * given ticker since the given date and store them in its price series.
+ */
+void backfill_share_price_history(const std::string& quote, budget::date from);
+
 void refresh_share_price_cache();
 void load_share_price_cache();
 void save_share_price_cache();
 
+/*!
+ * \brief Register the compaction job of the share price cache
+ */
+void schedule_share_jobs();
+
 } //end of namespace budget
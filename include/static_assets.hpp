@@ -0,0 +1,43 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+#include <string>
+#include <ostream>
+
+namespace httplib {
+struct Request;
+struct Response;
+};
+
+namespace budget {
+
+/*!
+ * \brief Load the static assets of the web interface in memory.
+ *
+ * The stylesheet of budgetwarrior is built in. The third-party libraries are
+ * loaded from the static folder of the budget directory, with the same
+ * layout as on cdnjs (for instance static/jquery/3.3.1/jquery.slim.min.js).
+ * The libraries that are not present there are loaded from the CDN.
+ */
+void load_static_assets();
+
+/*!
+ * \brief Write the tag (link or script) that loads the given asset.
+ * \param path The path of the asset, relative to the static folder
+ */
+void write_asset_tag(std::ostream& os, const std::string& path);
+
+/*!
+ * \brief Serve a static asset, from /static/<hash>/<path>.
+ *
+ * When the hash matches the content, the response is cacheable forever.
+ */
+void static_asset_page(const httplib::Request& req, httplib::Response& res);
+
+} //end of namespace budget
@@ -0,0 +1,34 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace budget {
+
+/*!
+ * \brief Returns the names of expenses starting with the prefix, the most used first.
+ *
+ * The names are compared regardless of the case. At most limit names are
+ * returned. The names are kept in a prefix tree, weighted by their number of
+ * expenses, so the cost does not depend on the number of expenses.
+ */
+std::vector<std::string> suggest_expense_names(const std::string& prefix, size_t limit = 10);
+
+/*!
+ * \brief Returns the names of earnings starting with the prefix, the most used first.
+ */
+std::vector<std::string> suggest_earning_names(const std::string& prefix, size_t limit = 10);
+
+/*!
+ * \brief Returns the names of accounts starting with the prefix, the most used first.
+ */
+std::vector<std::string> suggest_account_names(const std::string& prefix, size_t limit = 10);
+
+} //end of namespace budget
@@ -0,0 +1,50 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace budget {
+
+/*!
+ * \brief Start the threads of the task pool.
+ * \param threads The number of threads, 0 for the number of cores
+ */
+void start_task_pool(size_t threads = 0);
+
+/*!
+ * \brief Stop the task pool, after the pending tasks have been run
+ */
+void stop_task_pool();
+
+/*!
+ * \brief Run the task on the pool, or directly when the pool is not started
+ */
+void post_task(std::function<void()> task);
+
+/*!
+ * \brief Run the functor on the task pool.
+ *
+ * The tasks must not wait for other tasks of the pool.
+ *
+ * \return A future of the result of the functor, which rethrows its exception
+ */
+template <typename Functor>
+auto submit_task(Functor functor) -> std::future<decltype(functor())> {
+    // std::function needs a copyable task
+    auto task   = std::make_shared<std::packaged_task<decltype(functor())()>>(std::move(functor));
+    auto result = task->get_future();
+
+    post_task([task]() { (*task)(); });
+
+    return result;
+}
+
+} //end of namespace budget
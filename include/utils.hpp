@@ -64,6 +64,13 @@ bool folder_exists(const std::string& name);
 std::vector<std::string> split(const std::string &s, char delim);
 std::vector<std::string> &split(const std::string &s, char delim, std::vector<std::string> &elems);
 
+/*!
+ * \brief Parse a decimal number from [first, last) without allocating and
+ * independently of the current locale ('.' and ',' are both accepted as the
+ * decimal separator).
+ */
+double parse_double(const char* first, const char* last);
+
 std::string base64_decode(const std::string& in);
 std::string base64_encode(const std::string& in);
 
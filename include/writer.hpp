@@ -10,6 +10,7 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <functional>
 
 #include "date.hpp"
 #include "money.hpp"
@@ -59,6 +60,19 @@ struct set_button {
             : module(module) {}
 };
 
+/*!
+ * \brief Consumer of the rows of a streamed table
+ */
+using table_row_consumer = std::function<void(const std::vector<std::string>& row)>;
+
+/*!
+ * \brief Producer of the rows of a streamed table.
+ *
+ * The producer must give each row to the consumer, in order. It may be called
+ * several times and must produce the same rows each time.
+ */
+using table_row_producer = std::function<void(const table_row_consumer& consumer)>;
+
 struct writer {
     virtual writer& operator<<(const std::string& value) = 0;
     virtual writer& operator<<(const double& value) = 0;
@@ -92,6 +106,17 @@ struct writer {
     }
 
     virtual void display_table(std::vector<std::string>& columns, std::vector<std::vector<std::string>>& contents, size_t groups = 1, std::vector<size_t> lines = {}, size_t left = 0, size_t foot = 0) = 0;
+
+    /*!
+     * \brief Display a table whose rows are produced on demand.
+     *
+     * Only one row of the table is needed at a time. The footer rows are
+     * displayed after the produced rows.
+     *
+     * \param widths The maximum width of each column, when known. Otherwise,
+     * the console writer makes a first pass on the rows to compute them.
+     */
+    virtual void display_table(const std::vector<std::string>& columns, const table_row_producer& rows, const std::vector<std::vector<std::string>>& foot = {}, const std::vector<size_t>& widths = {}) = 0;
     virtual void display_graph(const std::string& title, std::vector<std::string>& categories, std::vector<std::string> series_names, std::vector<std::vector<float>>& series_values) = 0;
 };
 
@@ -116,13 +141,14 @@ struct console_writer : writer {
     virtual bool is_web() override;
 
     virtual void display_table(std::vector<std::string>& columns, std::vector<std::vector<std::string>>& contents, size_t groups = 1, std::vector<size_t> lines = {}, size_t left = 0, size_t foot = 0) override;
+    virtual void display_table(const std::vector<std::string>& columns, const table_row_producer& rows, const std::vector<std::vector<std::string>>& foot = {}, const std::vector<size_t>& widths = {}) override;
     virtual void display_graph(const std::string& title, std::vector<std::string>& categories, std::vector<std::string> series_names, std::vector<std::vector<float>>& series_values) override;
 };
 
 struct html_writer : writer {
-    std::stringstream& os;
+    std::ostream& os;
 
-    html_writer(std::stringstream& os);
+    html_writer(std::ostream& os);
 
     virtual writer& operator<<(const std::string& value) override;
     virtual writer& operator<<(const double& value) override;
@@ -144,6 +170,7 @@ struct html_writer : writer {
     virtual bool is_web() override;
 
     virtual void display_table(std::vector<std::string>& columns, std::vector<std::vector<std::string>>& contents, size_t groups = 1, std::vector<size_t> lines = {}, size_t left = 0, size_t foot = 0) override;
+    virtual void display_table(const std::vector<std::string>& columns, const table_row_producer& rows, const std::vector<std::vector<std::string>>& foot = {}, const std::vector<size_t>& widths = {}) override;
     virtual void display_graph(const std::string& title, std::vector<std::string>& categories, std::vector<std::string> series_names, std::vector<std::vector<float>>& series_values) override;
 
     void defer_script(const std::string& script);
@@ -151,6 +178,11 @@ struct html_writer : writer {
 
     void use_module(const std::string& module);
 
+    /*!
+     * \brief Take the deferred scripts and the modules of a writer of a part of the page
+     */
+    void merge_deferred(html_writer& rhs);
+
 private:
     std::vector<std::string> scripts;
     std::vector<std::string> modules;
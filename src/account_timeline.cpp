@@ -0,0 +1,85 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <algorithm>
+
+#include "account_timeline.hpp"
+#include "accounts.hpp"
+#include "data.hpp"
+
+namespace {
+
+budget::generation_cache<std::shared_ptr<const budget::account_timeline>> timeline_cache{"accounts"};
+
+size_t month_index(budget::year year, budget::month month){
+    return year * 12 + (month - 1);
+}
+
+size_t month_index(budget::date d){
+    return month_index(d.year(), d.month());
+}
+
+// The accounts are compared with the fifth day of the month
+std::shared_ptr<const budget::account_timeline> compute_timeline(){
+    auto result = std::make_shared<budget::account_timeline>();
+
+    // The number of accounts of each name that start (positive) or end (negative) in each month
+    std::map<size_t, std::map<std::string, int>> events;
+
+    for (auto& account : budget::all_accounts()) {
+        auto first = month_index(account.since) + (account.since.day() < 5 ? 0 : 1);
+        auto last  = month_index(account.until) + 1 - (account.until.day() > 5 ? 0 : 1);
+
+        // last is one past the last active month
+        if (first >= last) {
+            continue;
+        }
+
+        result->intervals[account.name].emplace_back(first, last - 1);
+
+        ++events[first][account.name];
+        --events[last][account.name];
+    }
+
+    for (auto& event : events) {
+        for (auto& name : event.second) {
+            if (name.second) {
+                result->changes.push_back(event.first);
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+} // end of anonymous namespace
+
+bool budget::account_timeline::changes_between(budget::year first_year, budget::month first_month, budget::year last_year, budget::month last_month) const {
+    auto it = std::upper_bound(changes.begin(), changes.end(), month_index(first_year, first_month));
+    return it != changes.end() && *it <= month_index(last_year, last_month);
+}
+
+std::vector<std::string> budget::account_timeline::names(budget::year year, budget::month month) const {
+    auto index = month_index(year, month);
+
+    std::vector<std::string> result;
+
+    for (auto& name : intervals) {
+        for (auto& interval : name.second) {
+            if (interval.first <= index && index <= interval.second) {
+                result.push_back(name.first);
+            }
+        }
+    }
+
+    return result;
+}
+
+std::shared_ptr<const budget::account_timeline> budget::accounts_timeline(){
+    return timeline_cache.get(&compute_timeline);
+}
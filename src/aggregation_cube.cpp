@@ -0,0 +1,75 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <cctype>
+#include <algorithm>
+#include <unordered_map>
+
+#include "aggregation_cube.hpp"
+#include "columns.hpp"
+#include "data.hpp"
+
+namespace {
+
+budget::generation_cache<std::shared_ptr<const budget::aggregation_cube>> expenses_cache{"expenses"};
+
+std::string trimmed_name(const std::string& name){
+    if (!name.empty() && name.back() == ' ') {
+        return name.substr(0, name.size() - 1);
+    }
+
+    return name;
+}
+
+std::string normalized_name(const std::string& name){
+    auto normalized = trimmed_name(name);
+    std::transform(normalized.begin(), normalized.end(), normalized.begin(), ::tolower);
+    return normalized;
+}
+
+std::shared_ptr<const budget::aggregation_cube> compute_cube(const budget::data_columns& columns){
+    auto cube = std::make_shared<budget::aggregation_cube>();
+
+    // The names are only normalized once for each distinct name, each
+    // interned name is given the id of its normalized name in the cube
+    std::vector<uint32_t> name_ids;
+    name_ids.reserve(columns.name_table.size());
+
+    std::unordered_map<std::string, uint32_t> normalized_ids;
+
+    for (auto& name : columns.name_table) {
+        auto inserted = normalized_ids.emplace(normalized_name(name), cube->labels.size());
+
+        if (inserted.second) {
+            cube->labels.push_back(trimmed_name(name));
+        }
+
+        name_ids.push_back(inserted.first->second);
+    }
+
+    for (size_t i = 0; i < columns.size(); ++i) {
+        auto month = columns.months[i];
+
+        budget::cube_key key{budget::date_type(month / 12), budget::date_type(month % 12 + 1), columns.accounts[i], name_ids[columns.names[i]]};
+
+        auto& cell = cube->cells[key];
+        cell.sum.value += columns.amounts[i];
+        ++cell.count;
+    }
+
+    return cube;
+}
+
+} // end of anonymous namespace
+
+const std::string& budget::aggregation_cube::label(uint32_t name) const {
+    return labels[name];
+}
+
+std::shared_ptr<const budget::aggregation_cube> budget::expenses_cube(){
+    return expenses_cache.get([]() { return compute_cube(*expenses_columns()); });
+}
@@ -15,6 +15,7 @@
 #include "config.hpp"
 #include "utils.hpp"
 #include "http.hpp"
+#include "compression.hpp"
 
 namespace {
 
@@ -31,6 +32,7 @@ budget::api_response base_api_get(Cli& cli, const std::string& api, bool silent)
     req.progress = [](int64_t,int64_t) -> bool { return true; };
 
     req.set_header("Accept", "*/*");
+    req.set_header("Accept-Encoding", "gzip, deflate");
     req.set_header("User-Agent", "cpp-httplib/0.1");
 
     if (budget::is_secure()) {
@@ -67,6 +69,20 @@ budget::api_response base_api_get(Cli& cli, const std::string& api, bool silent)
         }
 
         return {false, ""};
+    } else if (res->has_header("Content-Encoding")) {
+        std::string body;
+
+        if (!budget::decompress(res->body, body)) {
+            if (!silent) {
+                std::cerr << "Request to the API failed!" << std::endl;
+                std::cerr << "  API: " << server << ":" << server_port << "/" << api_complete << std::endl;
+                std::cerr << "  Invalid " << res->get_header_value("Content-Encoding") << " content" << std::endl;
+            }
+
+            return {false, ""};
+        }
+
+        return {true, body};
     } else {
         return {true, res->body};
     }
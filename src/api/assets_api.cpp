@@ -9,6 +9,7 @@
 
 #include "api/server_api.hpp"
 #include "api/assets_api.hpp"
+#include "api/table_api.hpp"
 
 #include "assets.hpp"
 #include "accounts.hpp"
@@ -332,3 +333,22 @@ void budget::list_asset_shares_api(const httplib::Request& req, httplib::Respons
 
     api_success_content(req, res, ss.str());
 }
+
+void budget::table_asset_values_api(const httplib::Request& req, httplib::Response& res) {
+    if (!api_start(req, res)) {
+        return;
+    }
+
+    auto& values = all_asset_values();
+
+    std::vector<table_column> columns{
+        {[&values](size_t i) { return get_asset(values[i].asset_id).name; },
+         [&values](size_t lhs, size_t rhs) { return get_asset(values[lhs].asset_id).name < get_asset(values[rhs].asset_id).name; }, true},
+        {[&values](size_t i) { return to_string(values[i].amount); },
+         [&values](size_t lhs, size_t rhs) { return values[lhs].amount < values[rhs].amount; }},
+        {[&values](size_t i) { return to_string(values[i].set_date); },
+         [&values](size_t lhs, size_t rhs) { return values[lhs].set_date < values[rhs].set_date; }},
+        {[&values](size_t i) { return "::edit::asset_values::" + to_string(values[i].id); }}};
+
+    table_api(req, res, values.size(), columns, [&values](size_t i) { return values[i].set_date; });
+}
@@ -9,6 +9,7 @@
 
 #include "api/server_api.hpp"
 #include "api/debts_api.hpp"
+#include "api/table_api.hpp"
 
 #include "debts.hpp"
 #include "accounts.hpp"
@@ -106,3 +107,26 @@ void budget::list_debts_api(const httplib::Request& req, httplib::Response& res)
 
     api_success_content(req, res, ss.str());
 }
+
+void budget::table_debts_api(const httplib::Request& req, httplib::Response& res) {
+    if (!api_start(req, res)) {
+        return;
+    }
+
+    auto& debts = all_debts();
+
+    std::vector<table_column> columns{
+        {[&debts](size_t i) { return std::string(debts[i].direction ? "to" : "from"); },
+         [&debts](size_t lhs, size_t rhs) { return debts[lhs].direction < debts[rhs].direction; }},
+        {[&debts](size_t i) { return debts[i].name; },
+         [&debts](size_t lhs, size_t rhs) { return debts[lhs].name < debts[rhs].name; }, true},
+        {[&debts](size_t i) { return to_string(debts[i].amount); },
+         [&debts](size_t lhs, size_t rhs) { return debts[lhs].amount < debts[rhs].amount; }},
+        {[&debts](size_t i) { return std::string(debts[i].state == 0 ? "No" : "Yes"); },
+         [&debts](size_t lhs, size_t rhs) { return debts[lhs].state < debts[rhs].state; }},
+        {[&debts](size_t i) { return debts[i].title; },
+         [&debts](size_t lhs, size_t rhs) { return debts[lhs].title < debts[rhs].title; }, true},
+        {[&debts](size_t i) { return "::edit::debts::" + to_string(debts[i].id); }}};
+
+    table_api(req, res, debts.size(), columns, [&debts](size_t i) { return debts[i].creation_date; });
+}
@@ -6,11 +6,15 @@
 //=======================================================================
 
 #include <set>
+#include <unordered_map>
 
 #include "api/server_api.hpp"
 #include "api/earnings_api.hpp"
+#include "api/table_api.hpp"
 
 #include "earnings.hpp"
+#include "search_index.hpp"
+#include "accounts.hpp"
 #include "guid.hpp"
 #include "http.hpp"
 
@@ -102,3 +106,31 @@ void budget::list_earnings_api(const httplib::Request& req, httplib::Response& r
 
     api_success_content(req, res, ss.str());
 }
+
+void budget::table_earnings_api(const httplib::Request& req, httplib::Response& res) {
+    if (!api_start(req, res)) {
+        return;
+    }
+
+    auto& earnings = all_earnings();
+
+    // The names of the accounts are resolved once, not in each comparison
+    std::unordered_map<size_t, std::string> account_names;
+
+    for (auto& account : all_accounts()) {
+        account_names[account.id] = account.name;
+    }
+
+    std::vector<table_column> columns{
+        {[&earnings](size_t i) { return to_string(earnings[i].date); },
+         [&earnings](size_t lhs, size_t rhs) { return earnings[lhs].date < earnings[rhs].date; }},
+        {[&earnings, &account_names](size_t i) { return account_names[earnings[i].account]; },
+         [&earnings, &account_names](size_t lhs, size_t rhs) { return account_names[earnings[lhs].account] < account_names[earnings[rhs].account]; }},
+        {[&earnings](size_t i) { return earnings[i].name; },
+         [&earnings](size_t lhs, size_t rhs) { return earnings[lhs].name < earnings[rhs].name; }, true},
+        {[&earnings](size_t i) { return to_string(earnings[i].amount); },
+         [&earnings](size_t lhs, size_t rhs) { return earnings[lhs].amount < earnings[rhs].amount; }},
+        {[&earnings](size_t i) { return "::edit::earnings::" + to_string(earnings[i].id); }}};
+
+    table_api(req, res, earnings.size(), columns, [&earnings](size_t i) { return earnings[i].date; }, [](const std::string& search) { return search_earnings_index(search); });
+}
@@ -6,11 +6,15 @@
 //=======================================================================
 
 #include <set>
+#include <unordered_map>
 
 #include "api/server_api.hpp"
 #include "api/expenses_api.hpp"
+#include "api/table_api.hpp"
 
 #include "expenses.hpp"
+#include "search_index.hpp"
+#include "accounts.hpp"
 #include "guid.hpp"
 #include "http.hpp"
 
@@ -102,3 +106,31 @@ void budget::list_expenses_api(const httplib::Request& req, httplib::Response& r
 
     api_success_content(req, res, ss.str());
 }
+
+void budget::table_expenses_api(const httplib::Request& req, httplib::Response& res) {
+    if (!api_start(req, res)) {
+        return;
+    }
+
+    auto& expenses = all_expenses();
+
+    // The names of the accounts are resolved once, not in each comparison
+    std::unordered_map<size_t, std::string> account_names;
+
+    for (auto& account : all_accounts()) {
+        account_names[account.id] = account.name;
+    }
+
+    std::vector<table_column> columns{
+        {[&expenses](size_t i) { return to_string(expenses[i].date); },
+         [&expenses](size_t lhs, size_t rhs) { return expenses[lhs].date < expenses[rhs].date; }},
+        {[&expenses, &account_names](size_t i) { return account_names[expenses[i].account]; },
+         [&expenses, &account_names](size_t lhs, size_t rhs) { return account_names[expenses[lhs].account] < account_names[expenses[rhs].account]; }},
+        {[&expenses](size_t i) { return expenses[i].name; },
+         [&expenses](size_t lhs, size_t rhs) { return expenses[lhs].name < expenses[rhs].name; }, true},
+        {[&expenses](size_t i) { return to_string(expenses[i].amount); },
+         [&expenses](size_t lhs, size_t rhs) { return expenses[lhs].amount < expenses[rhs].amount; }},
+        {[&expenses](size_t i) { return "::edit::expenses::" + to_string(expenses[i].id); }}};
+
+    table_api(req, res, expenses.size(), columns, [&expenses](size_t i) { return expenses[i].date; }, [](const std::string& search) { return search_expenses_index(search); });
+}
@@ -0,0 +1,136 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <algorithm>
+#include <functional>
+
+#include "api/server_api.hpp"
+#include "api/series_api.hpp"
+
+#include "assets.hpp"
+#include "config.hpp"
+#include "retirement.hpp"
+#include "series.hpp"
+#include "http.hpp"
+
+using namespace budget;
+
+namespace {
+
+// More points than this are never useful for a chart, with fewer points
+// the series would not be downsampled at all
+constexpr const size_t min_series_points = 3;
+constexpr const size_t max_series_points = 10000;
+constexpr const size_t default_series_points = 1000;
+
+bool parse_date_param(const httplib::Request& req, const char* name, budget::date& date){
+    if (!req.has_param(name)) {
+        return true;
+    }
+
+    auto value = req.get_param_value(name);
+
+    if (value.size() != 10) {
+        return false;
+    }
+
+    try {
+        date = budget::from_string(value);
+    } catch (const budget::date_exception&) {
+        return false;
+    }
+
+    return true;
+}
+
+// Compute the series, one value per day, on the requested range and downsample it
+template <typename T>
+void series_api(const httplib::Request& req, httplib::Response& res, const std::function<std::vector<T>(budget::date, budget::date)>& values){
+    auto start = budget::asset_start_date();
+    auto end   = budget::local_day();
+
+    if (!parse_date_param(req, "start", start) || !parse_date_param(req, "end", end)) {
+        api_error(req, res, "Invalid dates");
+        return;
+    }
+
+    start = std::max(start, budget::asset_start_date());
+    end   = std::min(end, budget::local_day());
+
+    size_t points = default_series_points;
+
+    if (req.has_param("points")) {
+        auto value = req.get_param_value("points");
+
+        if (value.empty() || !std::all_of(value.begin(), value.end(), ::isdigit)) {
+            api_error(req, res, "Invalid points");
+            return;
+        }
+
+        points = std::max(min_series_points, std::min(max_series_points, to_number<size_t>(value)));
+    }
+
+    std::vector<budget::series_point> series;
+
+    if (start <= end) {
+        auto daily = values(start, end);
+        auto first = budget::day_number(start);
+
+        for (size_t i = 0; i < daily.size(); ++i) {
+            series.push_back({(first + long(i)) * 24 * 3600 * 1000, double(daily[i])});
+        }
+    }
+
+    if (req.has_param("method") && req.get_param_value("method") == "minmax") {
+        // With its two points by bucket, min-max needs at least one bucket
+        series = budget::downsample_min_max(series, std::max<size_t>(points, 4));
+    } else {
+        series = budget::downsample_lttb(series, points);
+    }
+
+    // The response is compressed by the page cache
+    res.set_content(series_to_json(series), "application/json");
+}
+
+} //end of anonymous namespace
+
+void budget::net_worth_series_api(const httplib::Request& req, httplib::Response& res) {
+    if (!api_start(req, res)) {
+        return;
+    }
+
+    series_api<double>(req, res, [](budget::date start, budget::date end) {
+        std::vector<double> values;
+
+        for (auto& value : budget::get_net_worth_series(start, end, false)) {
+            values.push_back(double(value.value) / budget::SCALE);
+        }
+
+        return values;
+    });
+}
+
+void budget::fi_ratio_series_api(const httplib::Request& req, httplib::Response& res) {
+    if (!api_start(req, res)) {
+        return;
+    }
+
+    if (!internal_config_contains("withdrawal_rate")) {
+        api_error(req, res, "The retirement options are not configured");
+        return;
+    }
+
+    series_api<float>(req, res, [](budget::date start, budget::date end) {
+        auto values = budget::fi_ratio_series(start, end);
+
+        for (auto& value : values) {
+            value *= 100.0f;
+        }
+
+        return values;
+    });
+}
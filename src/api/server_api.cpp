@@ -18,11 +18,16 @@
 #include "api/wishes_api.hpp"
 #include "api/fortunes_api.hpp"
 #include "api/assets_api.hpp"
+#include "api/series_api.hpp"
+#include "api/suggestions_api.hpp"
+
+#include "pages/page_cache.hpp"
 
 #include "config.hpp"
 #include "version.hpp"
 #include "writer.hpp"
 #include "http.hpp"
+#include "compression.hpp"
 
 using namespace budget;
 
@@ -63,6 +68,14 @@ void server_version_support_api(const httplib::Request& req, httplib::Response&
     }
 }
 
+void server_metrics_api(const httplib::Request& req, httplib::Response& res) {
+    if (!api_start(req, res)) {
+        return;
+    }
+
+    res.set_content(metrics_text(), "text/plain; version=0.0.4");
+}
+
 void retirement_configure_api(const httplib::Request& req, httplib::Response& res) {
     if (!api_start(req, res)) {
         return;
@@ -84,10 +97,11 @@ void retirement_configure_api(const httplib::Request& req, httplib::Response& re
 
 } //end of anonymous namespace
 
-void budget::load_api(httplib::Server& server) {
+void budget::load_api(budget::metered_server& server) {
     server.Get("/api/server/up/", &server_up_api);
     server.Get("/api/server/version/", &server_version_api);
     server.Post("/api/server/version/support/", &server_version_support_api);
+    server.Get("/api/server/metrics/", &server_metrics_api);
 
     server.Post("/api/accounts/add/", &add_accounts_api);
     server.Post("/api/accounts/edit/", &edit_accounts_api);
@@ -95,6 +109,7 @@ void budget::load_api(httplib::Server& server) {
     server.Post("/api/accounts/archive/month/", &archive_accounts_month_api);
     server.Post("/api/accounts/archive/year/", &archive_accounts_year_api);
     server.Get("/api/accounts/list/", &list_accounts_api);
+    server.Get("/api/accounts/suggest/", &suggest_accounts_api);
 
     server.Post("/api/incomes/add/", &add_incomes_api);
     server.Post("/api/incomes/edit/", &edit_incomes_api);
@@ -105,11 +120,15 @@ void budget::load_api(httplib::Server& server) {
     server.Post("/api/expenses/edit/", &edit_expenses_api);
     server.Post("/api/expenses/delete/", &delete_expenses_api);
     server.Get("/api/expenses/list/", &list_expenses_api);
+    server.Get("/api/expenses/table/", &table_expenses_api);
+    server.Get("/api/expenses/suggest/", &suggest_expenses_api);
 
     server.Post("/api/earnings/add/", &add_earnings_api);
     server.Post("/api/earnings/edit/", &edit_earnings_api);
     server.Post("/api/earnings/delete/", &delete_earnings_api);
     server.Get("/api/earnings/list/", &list_earnings_api);
+    server.Get("/api/earnings/table/", &table_earnings_api);
+    server.Get("/api/earnings/suggest/", &suggest_earnings_api);
 
     server.Post("/api/recurrings/add/", &add_recurrings_api);
     server.Post("/api/recurrings/edit/", &edit_recurrings_api);
@@ -120,6 +139,7 @@ void budget::load_api(httplib::Server& server) {
     server.Post("/api/debts/edit/", &edit_debts_api);
     server.Post("/api/debts/delete/", &delete_debts_api);
     server.Get("/api/debts/list/", &list_debts_api);
+    server.Get("/api/debts/table/", &table_debts_api);
 
     server.Post("/api/fortunes/add/", &add_fortunes_api);
     server.Post("/api/fortunes/edit/", &edit_fortunes_api);
@@ -141,6 +161,7 @@ void budget::load_api(httplib::Server& server) {
     server.Post("/api/asset_values/batch/", &batch_asset_values_api);
     server.Post("/api/asset_values/delete/", &delete_asset_values_api);
     server.Get("/api/asset_values/list/", &list_asset_values_api);
+    server.Get("/api/asset_values/table/", &table_asset_values_api);
 
     server.Post("/api/asset_shares/add/", &add_asset_shares_api);
     server.Post("/api/asset_shares/edit/", &edit_asset_shares_api);
@@ -153,6 +174,13 @@ void budget::load_api(httplib::Server& server) {
     server.Post("/api/objectives/edit/", &edit_objectives_api);
     server.Post("/api/objectives/delete/", &delete_objectives_api);
     server.Get("/api/objectives/list/", &list_objectives_api);
+
+    // The series are computed day by day, they are cached like the pages
+    const std::vector<std::string> net_worth_modules{"assets", "asset_values", "asset_shares", "currency", "share_prices"};
+    const std::vector<std::string> fi_modules{"assets", "asset_values", "asset_shares", "currency", "share_prices", "expenses"};
+
+    server.Get("/api/series/net_worth/", cached_page(&net_worth_series_api, net_worth_modules));
+    server.Get("/api/series/fi_ratio/", cached_page(&fi_ratio_series_api, fi_modules));
 }
 
 bool budget::api_start(const httplib::Request& req, httplib::Response& res) {
@@ -231,8 +259,25 @@ void budget::api_success(const httplib::Request& req, httplib::Response& res, co
     }
 }
 
-void budget::api_success_content(const httplib::Request& /*req*/, httplib::Response& res, const std::string& content) {
-    res.set_content(content, "text/plain");
+void budget::api_success_content(const httplib::Request& req, httplib::Response& res, const std::string& content, const char* content_type) {
+    // The lists can be large, they are compressed if the client supports it
+    if (content.size() >= compression_threshold) {
+        auto encoding = negotiate_encoding(req.get_header_value("Accept-Encoding"));
+
+        if (!encoding.empty()) {
+            auto compressed = compress(content, encoding);
+
+            if (!compressed.empty()) {
+                res.set_header("Content-Encoding", encoding.c_str());
+                res.set_header("Vary", "Accept-Encoding");
+                res.set_content(compressed, content_type);
+
+                return;
+            }
+        }
+    }
+
+    res.set_content(content, content_type);
 }
 
 bool budget::parameters_present(const httplib::Request& req, std::vector<const char*> parameters) {
@@ -0,0 +1,80 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <algorithm>
+#include <sstream>
+
+#include "api/server_api.hpp"
+#include "api/suggestions_api.hpp"
+#include "api/table_api.hpp"
+
+#include "suggestions.hpp"
+#include "utils.hpp"
+#include "http.hpp"
+
+using namespace budget;
+
+namespace {
+
+constexpr const size_t default_suggestions = 10;
+constexpr const size_t max_suggestions     = 100;
+
+// Answer with the names starting with the prefix parameter, as a JSON array
+void suggestions_api(const httplib::Request& req, httplib::Response& res, std::vector<std::string> (*suggest)(const std::string&, size_t)){
+    if (!api_start(req, res)) {
+        return;
+    }
+
+    if (!parameters_present(req, {"prefix"})) {
+        api_error(req, res, "Invalid parameters");
+        return;
+    }
+
+    size_t limit = default_suggestions;
+
+    if (req.has_param("limit")) {
+        auto value = req.get_param_value("limit");
+
+        if (value.empty() || !std::all_of(value.begin(), value.end(), ::isdigit)) {
+            api_error(req, res, "Invalid limit");
+            return;
+        }
+
+        limit = std::min(to_number<size_t>(value), max_suggestions);
+    }
+
+    std::stringstream ss;
+    ss << '[';
+
+    bool first = true;
+    for (auto& name : suggest(req.get_param_value("prefix"), limit)) {
+        if (!first) {
+            ss << ',';
+        }
+
+        write_json_string(ss, name);
+        first = false;
+    }
+
+    ss << ']';
+
+    api_success_content(req, res, ss.str(), "application/json");
+}
+
+} //end of anonymous namespace
+
+void budget::suggest_expenses_api(const httplib::Request& req, httplib::Response& res) {
+    suggestions_api(req, res, &suggest_expense_names);
+}
+
+void budget::suggest_earnings_api(const httplib::Request& req, httplib::Response& res) {
+    suggestions_api(req, res, &suggest_earning_names);
+}
+
+void budget::suggest_accounts_api(const httplib::Request& req, httplib::Response& res) {
+    suggestions_api(req, res, &suggest_account_names);
+}
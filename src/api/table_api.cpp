@@ -0,0 +1,290 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <algorithm>
+#include <ostream>
+#include <streambuf>
+
+#include "api/server_api.hpp"
+#include "api/table_api.hpp"
+
+#include "utils.hpp"
+#include "writer.hpp"
+#include "chunked_buffer.hpp"
+#include "http.hpp"
+
+using namespace budget;
+
+namespace {
+
+// Even when the client asks for all the rows, the pages are bounded
+constexpr const size_t default_page_length = 10;
+constexpr const size_t max_page_length     = 1000;
+
+size_t size_param(const httplib::Request& req, const char* name, size_t default_value){
+    if (!req.has_param(name)) {
+        return default_value;
+    }
+
+    auto value = req.get_param_value(name);
+
+    if (value.empty() || !std::all_of(value.begin(), value.end(), ::isdigit)) {
+        return default_value;
+    }
+
+    return to_number<size_t>(value);
+}
+
+bool date_param(const httplib::Request& req, const char* name, budget::date& date){
+    if (!req.has_param(name)) {
+        return false;
+    }
+
+    auto value = req.get_param_value(name);
+
+    if (value.size() != 10) {
+        return false;
+    }
+
+    try {
+        date = budget::from_string(value);
+    } catch (const budget::date_exception&) {
+        return false;
+    }
+
+    return true;
+}
+
+void to_lower(std::string& value){
+    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+}
+
+// The back page of the edit buttons is written in HTML attributes
+std::string back_page(const httplib::Request& req){
+    auto page = req.get_param_value("back_page");
+
+    auto valid = [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '/' || c == '_' || c == '-'; };
+
+    if (page.empty() || page[0] != '/' || !std::all_of(page.begin(), page.end(), valid)) {
+        return "/";
+    }
+
+    return page;
+}
+
+// Write the characters escaped for a JSON string, the runs without any
+// special character are written at once
+void write_json_escaped(std::ostream& os, const char* s, size_t n){
+    const char* first = s;
+    const char* last  = s + n;
+
+    for (const char* c = first; c != last; ++c) {
+        const char* escaped = nullptr;
+
+        switch (*c) {
+            case '"':
+                escaped = "\\\"";
+                break;
+            case '\\':
+                escaped = "\\\\";
+                break;
+            case '\n':
+                escaped = "\\n";
+                break;
+            case '\r':
+                escaped = "\\r";
+                break;
+            case '\t':
+                escaped = "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(*c) >= 0x20) {
+                    continue;
+                }
+        }
+
+        os.write(first, c - first);
+        first = c + 1;
+
+        if (escaped) {
+            os << escaped;
+        } else {
+            os << "\\u00" << "0123456789abcdef"[(*c >> 4) & 0xF] << "0123456789abcdef"[*c & 0xF];
+        }
+    }
+
+    os.write(first, last - first);
+}
+
+/*
+ * A stream buffer escaping everything written through it into a JSON string.
+ *
+ * The cells are rendered by an html_writer on top of it, directly into the
+ * response. The placeholders contain no special character, they are still
+ * written in a single write once escaped.
+ */
+struct json_escaping_buffer : std::streambuf {
+    std::ostream& os;
+
+    explicit json_escaping_buffer(std::ostream& os) : os(os) {}
+
+protected:
+    int_type overflow(int_type c) override {
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            char value = traits_type::to_char_type(c);
+            write_json_escaped(os, &value, 1);
+        }
+
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        write_json_escaped(os, s, n);
+        return n;
+    }
+};
+
+} //end of anonymous namespace
+
+void budget::write_json_string(std::ostream& os, const std::string& value){
+    os << '"';
+    write_json_escaped(os, value.data(), value.size());
+    os << '"';
+}
+
+void budget::table_api(const httplib::Request& req, httplib::Response& res, size_t rows, const std::vector<table_column>& columns,
+                       const std::function<budget::date(size_t row)>& date, const table_search& search_index) {
+    const size_t draw   = size_param(req, "draw", 0);
+    const size_t start  = size_param(req, "start", 0);
+    const size_t length = std::min(size_param(req, "length", default_page_length), max_page_length);
+
+    auto search = req.get_param_value("search[value]");
+    to_lower(search);
+
+    budget::date from;
+    budget::date to;
+
+    const bool has_from = date && date_param(req, "start_date", from);
+    const bool has_to   = date && date_param(req, "end_date", to);
+
+    auto in_range = [&](size_t i) {
+        if (has_from || has_to) {
+            auto row_date = date(i);
+
+            return !((has_from && row_date < from) || (has_to && to < row_date));
+        }
+
+        return true;
+    };
+
+    // 1. Filter the rows
+
+    std::vector<size_t> indexes;
+
+    if (!search.empty() && search_index) {
+        // The index gives the matching rows, in the order of its ranks
+        indexes = search_index(search);
+        std::sort(indexes.begin(), indexes.end());
+
+        indexes.erase(std::remove_if(indexes.begin(), indexes.end(), [&in_range](size_t i) { return !in_range(i); }), indexes.end());
+    } else {
+        indexes.reserve(rows);
+
+        std::string cell;
+
+        for (size_t i = 0; i < rows; ++i) {
+            if (!in_range(i)) {
+                continue;
+            }
+
+            if (!search.empty()) {
+                bool found = false;
+
+                for (auto& column : columns) {
+                    if (column.searchable) {
+                        cell = column.cell(i);
+                        to_lower(cell);
+
+                        if (cell.find(search) != std::string::npos) {
+                            found = true;
+                            break;
+                        }
+                    }
+                }
+
+                if (!found) {
+                    continue;
+                }
+            }
+
+            indexes.push_back(i);
+        }
+    }
+
+    // 2. Sort only the rows up to the requested page
+
+    const size_t first = std::min(start, indexes.size());
+    const size_t last  = std::min(indexes.size() - first, length) + first;
+
+    const size_t order = size_param(req, "order[0][column]", columns.size());
+    const bool desc    = req.get_param_value("order[0][dir]") == "desc";
+
+    if (order < columns.size() && columns[order].less && last > 0) {
+        auto& less = columns[order].less;
+
+        // Equal rows stay in their original order, for stable pages
+        auto compare = [&less, desc](size_t lhs, size_t rhs) {
+            bool before = desc ? less(rhs, lhs) : less(lhs, rhs);
+            bool after  = desc ? less(lhs, rhs) : less(rhs, lhs);
+
+            return before || (!after && lhs < rhs);
+        };
+
+        std::partial_sort(indexes.begin(), indexes.begin() + last, indexes.end(), compare);
+    }
+
+    // 3. Render the page of rows
+
+    budget::chunked_stream ss;
+    ss.imbue(std::locale("C"));
+    ss.buffer.add_placeholder("__budget_this_page__", back_page(req));
+
+    // The cells are rendered like the HTML tables do, escaped on the fly
+    json_escaping_buffer escaping(ss);
+    std::ostream cells(&escaping);
+    cells.imbue(std::locale("C"));
+    budget::html_writer w(cells);
+
+    ss << "{\"draw\":" << draw << ",\"recordsTotal\":" << rows << ",\"recordsFiltered\":" << indexes.size() << ",\"data\":[";
+
+    for (size_t i = first; i < last; ++i) {
+        if (i > first) {
+            ss << ',';
+        }
+
+        ss << '[';
+
+        for (size_t j = 0; j < columns.size(); ++j) {
+            if (j) {
+                ss << ',';
+            }
+
+            ss << '"';
+            w << columns[j].cell(indexes[i]);
+            ss << '"';
+        }
+
+        ss << ']';
+    }
+
+    ss << "]}";
+
+    std::string content;
+    ss.buffer.move_into(content);
+
+    api_success_content(req, res, content, "application/json");
+}
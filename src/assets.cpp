@@ -11,6 +11,7 @@
 #include <utility>
 #include <map>
 #include <random>
+#include <algorithm>
 
 #include "assets.hpp"
 #include "budget_exception.hpp"
@@ -1097,15 +1098,22 @@ void budget::list_asset_values(budget::writer& w){
     }
 
     std::vector<std::string> columns = {"ID", "Asset", "Amount", "Date", "Edit"};
-    std::vector<std::vector<std::string>> contents;
 
     // Display the asset values
 
-    for(auto& value : asset_values.data){
-        contents.push_back({to_string(value.id), get_asset(value.asset_id).name, to_string(value.amount), to_string(value.set_date), "::edit::asset_values::" + budget::to_string(value.id)});
-    }
+    w.display_table(columns, [](const table_row_consumer& consumer) {
+        std::vector<std::string> row(5);
 
-    w.display_table(columns, contents);
+        for (auto& value : asset_values.data) {
+            row[0] = to_string(value.id);
+            row[1] = get_asset(value.asset_id).name;
+            row[2] = to_string(value.amount);
+            row[3] = to_string(value.set_date);
+            row[4] = "::edit::asset_values::" + row[0];
+
+            consumer(row);
+        }
+    });
 }
 
 void budget::list_asset_shares(budget::writer& w){
@@ -1115,17 +1123,23 @@ void budget::list_asset_shares(budget::writer& w){
     }
 
     std::vector<std::string> columns = {"ID", "Asset", "Shares", "Date", "Price", "Edit"};
-    std::vector<std::vector<std::string>> contents;
 
-    // Display the asset values
+    // Display the asset shares
 
-    for (auto& value : asset_shares.data) {
-        contents.push_back({to_string(value.id), get_asset(value.asset_id).name,
-                            to_string(value.shares), to_string(value.date), to_string(value.price),
-                            "::edit::asset_shares::" + budget::to_string(value.id)});
-    }
+    w.display_table(columns, [](const table_row_consumer& consumer) {
+        std::vector<std::string> row(6);
 
-    w.display_table(columns, contents);
+        for (auto& value : asset_shares.data) {
+            row[0] = to_string(value.id);
+            row[1] = get_asset(value.asset_id).name;
+            row[2] = to_string(value.shares);
+            row[3] = to_string(value.date);
+            row[4] = to_string(value.price);
+            row[5] = "::edit::asset_shares::" + row[0];
+
+            consumer(row);
+        }
+    });
 }
 
 budget::money budget::get_portfolio_value(){
@@ -1154,6 +1168,72 @@ budget::money budget::get_net_worth(budget::date d){
     return total;
 }
 
+std::vector<budget::money> budget::get_net_worth_series(budget::date first, budget::date last, bool convert){
+    std::vector<budget::money> series;
+
+    if (last < first) {
+        return series;
+    }
+
+    series.resize(day_number(last) - day_number(first) + 1);
+
+    for (auto& asset : all_user_assets()) {
+        if (asset.share_based) {
+            std::vector<std::pair<budget::date, size_t>> purchases;
+
+            for (auto& asset_share : asset_shares.data) {
+                if (asset_share.asset_id == asset.id) {
+                    purchases.emplace_back(asset_share.date, asset_share.shares);
+                }
+            }
+
+            std::sort(purchases.begin(), purchases.end(), [](auto& lhs, auto& rhs) { return lhs.first < rhs.first; });
+
+            size_t shares = 0;
+            size_t next   = 0;
+            size_t i      = 0;
+
+            for (auto d = first; d <= last; d += days(1), ++i) {
+                while (next < purchases.size() && purchases[next].first <= d) {
+                    shares += purchases[next++].second;
+                }
+
+                if (shares) {
+                    auto value = budget::money(shares) * share_price(asset.ticker, d);
+                    series[i] += convert ? value * exchange_rate(asset.currency, d) : value;
+                }
+            }
+        } else {
+            std::vector<const budget::asset_value*> values;
+
+            for (auto& asset_value : asset_values.data) {
+                if (asset_value.asset_id == asset.id) {
+                    values.push_back(&asset_value);
+                }
+            }
+
+            // On the same date, the last value wins, as in get_asset_value
+            std::stable_sort(values.begin(), values.end(), [](auto* lhs, auto* rhs) { return lhs->set_date < rhs->set_date; });
+
+            const budget::asset_value* current = nullptr;
+            size_t next = 0;
+            size_t i    = 0;
+
+            for (auto d = first; d <= last; d += days(1), ++i) {
+                while (next < values.size() && values[next]->set_date <= d) {
+                    current = values[next++];
+                }
+
+                if (current) {
+                    series[i] += convert ? current->amount * exchange_rate(asset.currency, d) : current->amount;
+                }
+            }
+        }
+    }
+
+    return series;
+}
+
 budget::money budget::get_net_worth_cash(){
     budget::money total;
 
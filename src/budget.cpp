@@ -347,7 +347,7 @@ int main(int argc, const char* argv[]) {
         code = 2;
     }
 
-    // Save the caches
+    // Compact the caches, new entries have already been appended
     save_currency_cache();
     save_share_price_cache();
 
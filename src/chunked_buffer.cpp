@@ -0,0 +1,194 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <cstring>
+#include <algorithm>
+
+#include "chunked_buffer.hpp"
+
+namespace {
+
+// Most of the pages fit in the first chunk
+constexpr const size_t first_chunk_size = 64 * 1024;
+constexpr const size_t max_chunk_size   = 1024 * 1024;
+
+} // end of anonymous namespace
+
+budget::chunked_buffer::chunked_buffer() {
+    next_chunk();
+}
+
+void budget::chunked_buffer::add_placeholder(const std::string& placeholder, const std::string& value){
+    placeholders.emplace_back(placeholder, value);
+}
+
+void budget::chunked_buffer::copy_placeholders(const chunked_buffer& rhs){
+    placeholders = rhs.placeholders;
+}
+
+void budget::chunked_buffer::set_sink(sink_type sink){
+    this->sink = std::move(sink);
+
+    if (this->sink) {
+        flush_sink();
+    }
+}
+
+size_t budget::chunked_buffer::size() const {
+    return full_size + (pptr() - pbase());
+}
+
+void budget::chunked_buffer::next_chunk(){
+    // With a sink, the current chunk is reused once sent
+    if (sink && !chunks.empty()) {
+        flush_sink();
+        return;
+    }
+
+    size_t size = first_chunk_size;
+
+    // Close the current chunk
+    if (!chunks.empty()) {
+        auto& last = chunks.back();
+        last.resize(pptr() - pbase());
+        full_size += last.size();
+
+        size = std::min(2 * last.capacity(), max_chunk_size);
+    }
+
+    chunks.emplace_back();
+
+    auto& chunk = chunks.back();
+    chunk.resize(size);
+
+    setp(&chunk[0], &chunk[0] + chunk.size());
+}
+
+void budget::chunked_buffer::flush_sink(){
+    for_each_chunk([this](const char* data, size_t size) {
+        if (size) {
+            sink(data, size);
+        }
+    });
+
+    // Only the last chunk is kept, empty
+    if (chunks.size() > 1) {
+        auto last = std::move(chunks.back());
+        chunks.clear();
+        chunks.push_back(std::move(last));
+    }
+
+    full_size = 0;
+
+    auto& chunk = chunks.back();
+    setp(&chunk[0], &chunk[0] + chunk.size());
+}
+
+int budget::chunked_buffer::sync(){
+    if (sink) {
+        flush_sink();
+    }
+
+    return 0;
+}
+
+budget::chunked_buffer::int_type budget::chunked_buffer::overflow(int_type c){
+    if (traits_type::eq_int_type(c, traits_type::eof())) {
+        return traits_type::not_eof(c);
+    }
+
+    next_chunk();
+
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+
+    return c;
+}
+
+void budget::chunked_buffer::write_raw(const char* s, size_t n){
+    while (n) {
+        if (pptr() == epptr()) {
+            next_chunk();
+        }
+
+        size_t length = std::min<size_t>(n, epptr() - pptr());
+
+        std::memcpy(pptr(), s, length);
+        pbump(static_cast<int>(length));
+
+        s += length;
+        n -= length;
+    }
+}
+
+std::streamsize budget::chunked_buffer::xsputn(const char* s, std::streamsize n){
+    if (placeholders.empty()) {
+        write_raw(s, n);
+        return n;
+    }
+
+    const char* first = s;
+    const char* last  = s + n;
+    const char* current = first;
+
+    while (last - current >= 2) {
+        auto found = static_cast<const char*>(std::memchr(current, '_', last - current - 1));
+
+        if (!found) {
+            break;
+        }
+
+        if (found[1] != '_') {
+            current = found + 1;
+            continue;
+        }
+
+        bool replaced = false;
+
+        for (auto& placeholder : placeholders) {
+            auto& key = placeholder.first;
+
+            if (static_cast<size_t>(last - found) >= key.size() && std::memcmp(found, key.data(), key.size()) == 0) {
+                write_raw(first, found - first);
+                write_raw(placeholder.second.data(), placeholder.second.size());
+
+                first = current = found + key.size();
+                replaced = true;
+                break;
+            }
+        }
+
+        if (!replaced) {
+            current = found + 1;
+        }
+    }
+
+    write_raw(first, last - first);
+
+    return n;
+}
+
+void budget::chunked_buffer::move_into(std::string& result){
+    auto& last = chunks.back();
+    last.resize(pptr() - pbase());
+
+    if (chunks.size() == 1) {
+        result = std::move(last);
+    } else {
+        result.clear();
+        result.reserve(full_size + last.size());
+
+        for (auto& chunk : chunks) {
+            result += chunk;
+        }
+    }
+
+    chunks.clear();
+    full_size = 0;
+
+    next_chunk();
+}
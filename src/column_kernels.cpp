@@ -0,0 +1,171 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "column_kernels.hpp"
+
+namespace {
+
+// The scalar loops are branchless, the amounts are selected with a mask
+
+int64_t sum_range_scalar(const uint32_t* keys, const int64_t* amounts, size_t n, uint32_t first, uint32_t width){
+    int64_t sum = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        sum += amounts[i] & -int64_t(keys[i] - first <= width);
+    }
+
+    return sum;
+}
+
+int64_t sum_account_scalar(const uint32_t* keys, const uint32_t* accounts, const int64_t* amounts, size_t n, uint32_t first, uint32_t width, uint32_t target){
+    int64_t sum = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        sum += amounts[i] & -int64_t((keys[i] - first <= width) & (accounts[i] == target));
+    }
+
+    return sum;
+}
+
+#if defined(__GNUC__) && defined(__x86_64__)
+
+#define BUDGET_SIMD_KERNELS
+
+// x <= width, unsigned, is min(x, width) == x
+
+__attribute__((target("sse4.1"))) inline __m128i in_range_sse(const uint32_t* keys, __m128i first, __m128i width){
+    auto x = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys)), first);
+    return _mm_cmpeq_epi32(_mm_min_epu32(x, width), x);
+}
+
+// The 4 masks of 32 bits are widened to select the 4 amounts of 64 bits
+__attribute__((target("sse4.1"))) inline __m128i masked_amounts_sse(const int64_t* amounts, __m128i mask){
+    auto low  = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(amounts)), _mm_cvtepi32_epi64(mask));
+    auto high = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(amounts + 2)), _mm_cvtepi32_epi64(_mm_srli_si128(mask, 8)));
+    return _mm_add_epi64(low, high);
+}
+
+__attribute__((target("sse4.1"))) inline int64_t horizontal_sum_sse(__m128i sum){
+    return _mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1);
+}
+
+__attribute__((target("sse4.1"))) int64_t sum_range_sse(const uint32_t* keys, const int64_t* amounts, size_t n, uint32_t first, uint32_t width){
+    const auto vfirst = _mm_set1_epi32(first);
+    const auto vwidth = _mm_set1_epi32(width);
+
+    auto sum = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        sum = _mm_add_epi64(sum, masked_amounts_sse(amounts + i, in_range_sse(keys + i, vfirst, vwidth)));
+    }
+
+    return horizontal_sum_sse(sum) + sum_range_scalar(keys + i, amounts + i, n - i, first, width);
+}
+
+__attribute__((target("sse4.1"))) int64_t sum_account_sse(const uint32_t* keys, const uint32_t* accounts, const int64_t* amounts, size_t n, uint32_t first, uint32_t width, uint32_t target){
+    const auto vfirst  = _mm_set1_epi32(first);
+    const auto vwidth  = _mm_set1_epi32(width);
+    const auto vtarget = _mm_set1_epi32(target);
+
+    auto sum = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        auto account = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(accounts + i)), vtarget);
+        auto mask    = _mm_and_si128(in_range_sse(keys + i, vfirst, vwidth), account);
+        sum = _mm_add_epi64(sum, masked_amounts_sse(amounts + i, mask));
+    }
+
+    return horizontal_sum_sse(sum) + sum_account_scalar(keys + i, accounts + i, amounts + i, n - i, first, width, target);
+}
+
+__attribute__((target("avx2"))) inline __m256i in_range_avx2(const uint32_t* keys, __m256i first, __m256i width){
+    auto x = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys)), first);
+    return _mm256_cmpeq_epi32(_mm256_min_epu32(x, width), x);
+}
+
+// The 8 masks of 32 bits are widened to select the 8 amounts of 64 bits
+__attribute__((target("avx2"))) inline __m256i masked_amounts_avx2(const int64_t* amounts, __m256i mask){
+    auto low  = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(amounts)), _mm256_cvtepi32_epi64(_mm256_castsi256_si128(mask)));
+    auto high = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(amounts + 4)), _mm256_cvtepi32_epi64(_mm256_extracti128_si256(mask, 1)));
+    return _mm256_add_epi64(low, high);
+}
+
+__attribute__((target("avx2"))) inline int64_t horizontal_sum_avx2(__m256i sum){
+    auto half = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    return _mm_cvtsi128_si64(half) + _mm_extract_epi64(half, 1);
+}
+
+__attribute__((target("avx2"))) int64_t sum_range_avx2(const uint32_t* keys, const int64_t* amounts, size_t n, uint32_t first, uint32_t width){
+    const auto vfirst = _mm256_set1_epi32(first);
+    const auto vwidth = _mm256_set1_epi32(width);
+
+    auto sum = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        sum = _mm256_add_epi64(sum, masked_amounts_avx2(amounts + i, in_range_avx2(keys + i, vfirst, vwidth)));
+    }
+
+    return horizontal_sum_avx2(sum) + sum_range_scalar(keys + i, amounts + i, n - i, first, width);
+}
+
+__attribute__((target("avx2"))) int64_t sum_account_avx2(const uint32_t* keys, const uint32_t* accounts, const int64_t* amounts, size_t n, uint32_t first, uint32_t width, uint32_t target){
+    const auto vfirst  = _mm256_set1_epi32(first);
+    const auto vwidth  = _mm256_set1_epi32(width);
+    const auto vtarget = _mm256_set1_epi32(target);
+
+    auto sum = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        auto account = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(accounts + i)), vtarget);
+        auto mask    = _mm256_and_si256(in_range_avx2(keys + i, vfirst, vwidth), account);
+        sum = _mm256_add_epi64(sum, masked_amounts_avx2(amounts + i, mask));
+    }
+
+    return horizontal_sum_avx2(sum) + sum_account_scalar(keys + i, accounts + i, amounts + i, n - i, first, width, target);
+}
+
+#endif
+
+// The kernels supported by the processor, the fastest first
+std::vector<budget::column_kernels> detect_kernels(){
+    std::vector<budget::column_kernels> kernels;
+
+#ifdef BUDGET_SIMD_KERNELS
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back({"avx2", &sum_range_avx2, &sum_account_avx2});
+    }
+
+    if (__builtin_cpu_supports("sse4.1")) {
+        kernels.push_back({"sse4.1", &sum_range_sse, &sum_account_sse});
+    }
+#endif
+
+    kernels.push_back({"scalar", &sum_range_scalar, &sum_account_scalar});
+
+    return kernels;
+}
+
+} // end of anonymous namespace
+
+const std::vector<budget::column_kernels>& budget::supported_column_kernels(){
+    static const std::vector<budget::column_kernels> kernels = detect_kernels();
+    return kernels;
+}
+
+const budget::column_kernels& budget::best_column_kernels(){
+    return supported_column_kernels().front();
+}
@@ -0,0 +1,97 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <unordered_map>
+
+#include "columns.hpp"
+#include "column_kernels.hpp"
+#include "data.hpp"
+#include "expenses.hpp"
+#include "earnings.hpp"
+
+namespace {
+
+using columns_cache = budget::generation_cache<std::shared_ptr<const budget::data_columns>>;
+
+columns_cache expenses_cache{"expenses"};
+columns_cache earnings_cache{"earnings"};
+
+template <typename Data>
+std::shared_ptr<const budget::data_columns> compute_columns(const Data& data){
+    auto columns = std::make_shared<budget::data_columns>();
+
+    columns->months.reserve(data.size());
+    columns->accounts.reserve(data.size());
+    columns->amounts.reserve(data.size());
+    columns->names.reserve(data.size());
+
+    std::unordered_map<std::string, uint32_t> name_ids;
+
+    for (auto& entry : data) {
+        columns->months.push_back(budget::column_month(entry.date.year(), entry.date.month()));
+        columns->accounts.push_back(entry.account);
+        columns->amounts.push_back(entry.amount.value);
+
+        auto it = name_ids.find(entry.name);
+
+        if (it == name_ids.end()) {
+            it = name_ids.emplace(entry.name, columns->name_table.size()).first;
+            columns->name_table.push_back(entry.name);
+        }
+
+        columns->names.push_back(it->second);
+    }
+
+    return columns;
+}
+
+budget::money make_money(int64_t value){
+    budget::money result;
+    result.value = value;
+    return result;
+}
+
+} // end of anonymous namespace
+
+std::shared_ptr<const budget::data_columns> budget::expenses_columns(){
+    return expenses_cache.get([]() { return compute_columns(all_expenses()); });
+}
+
+std::shared_ptr<const budget::data_columns> budget::earnings_columns(){
+    return earnings_cache.get([]() { return compute_columns(all_earnings()); });
+}
+
+budget::money budget::sum_amounts(const data_columns& columns, uint32_t first_month, uint32_t last_month){
+    if (last_month < first_month) {
+        return {};
+    }
+
+    return make_money(best_column_kernels().sum_range(columns.months.data(), columns.amounts.data(), columns.size(), first_month, last_month - first_month));
+}
+
+budget::money budget::sum_amounts(const data_columns& columns, size_t account, uint32_t first_month, uint32_t last_month){
+    if (last_month < first_month) {
+        return {};
+    }
+
+    return make_money(best_column_kernels().sum_account(columns.months.data(), columns.accounts.data(), columns.amounts.data(), columns.size(), first_month, last_month - first_month, account));
+}
+
+void budget::bucket_amounts(const data_columns& columns, uint32_t first_month, std::vector<budget::money>& buckets){
+    const uint32_t* months = columns.months.data();
+    const int64_t* amounts = columns.amounts.data();
+    const size_t n         = columns.size();
+    const size_t size      = buckets.size();
+
+    for (size_t i = 0; i < n; ++i) {
+        size_t bucket = months[i] - first_month;
+
+        if (bucket < size) {
+            buckets[bucket].value += amounts[i];
+        }
+    }
+}
@@ -0,0 +1,135 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <algorithm>
+
+#include <zlib.h>
+
+#include "compression.hpp"
+#include "utils.hpp"
+
+namespace {
+
+// Quality of the given encoding in the Accept-Encoding header (0 if not accepted)
+// The exact name of the encoding takes precedence over the * wildcard
+double encoding_quality(const std::string& accept_encoding, const std::string& encoding){
+    bool wildcard          = false;
+    double wildcard_quality = 0.0;
+
+    for (auto& part : budget::split(accept_encoding, ',')) {
+        auto name_end = part.find(';');
+
+        auto name = part.substr(0, name_end);
+        name.erase(std::remove(name.begin(), name.end(), ' '), name.end());
+
+        if (name != encoding && name != "*") {
+            continue;
+        }
+
+        double quality = 1.0;
+
+        if (name_end != std::string::npos) {
+            auto q = part.find("q=", name_end);
+
+            if (q != std::string::npos) {
+                quality = budget::parse_double(part.data() + q + 2, part.data() + part.size());
+            }
+        }
+
+        if (name == encoding) {
+            return quality;
+        }
+
+        if (!wildcard) {
+            wildcard         = true;
+            wildcard_quality = quality;
+        }
+    }
+
+    return wildcard_quality;
+}
+
+} // end of anonymous namespace
+
+std::string budget::negotiate_encoding(const std::string& accept_encoding){
+    auto gzip    = encoding_quality(accept_encoding, "gzip");
+    auto deflate = encoding_quality(accept_encoding, "deflate");
+
+    if (gzip > 0.0 && gzip >= deflate) {
+        return "gzip";
+    } else if (deflate > 0.0) {
+        return "deflate";
+    }
+
+    return "";
+}
+
+std::string budget::compress(const std::string& data, const std::string& encoding){
+    z_stream stream{};
+
+    // 15 bits of window, +16 for a gzip header and trailer instead of zlib ones
+    int window_bits = encoding == "gzip" ? 15 + 16 : 15;
+
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return "";
+    }
+
+    std::string result;
+    result.resize(deflateBound(&stream, data.size()));
+
+    stream.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in  = data.size();
+    stream.next_out  = reinterpret_cast<Bytef*>(&result[0]);
+    stream.avail_out = result.size();
+
+    // The output buffer is large enough for the data to be compressed in one call
+    if (deflate(&stream, Z_FINISH) != Z_STREAM_END) {
+        deflateEnd(&stream);
+        return "";
+    }
+
+    result.resize(stream.total_out);
+
+    deflateEnd(&stream);
+
+    return result;
+}
+
+bool budget::decompress(const std::string& data, std::string& result){
+    z_stream stream{};
+
+    // +32 detects automatically the zlib or gzip header
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+        return false;
+    }
+
+    stream.next_in  = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = data.size();
+
+    result.clear();
+
+    char buffer[16384];
+    int ret;
+
+    do {
+        stream.next_out  = reinterpret_cast<Bytef*>(buffer);
+        stream.avail_out = sizeof(buffer);
+
+        ret = inflate(&stream, Z_NO_FLUSH);
+
+        if (ret != Z_OK && ret != Z_STREAM_END) {
+            inflateEnd(&stream);
+            return false;
+        }
+
+        result.append(buffer, sizeof(buffer) - stream.avail_out);
+    } while (ret != Z_STREAM_END);
+
+    inflateEnd(&stream);
+
+    return true;
+}
@@ -5,6 +5,11 @@
 //  http://opensource.org/licenses/MIT)
 //=======================================================================
 
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+#include <atomic>
 #include <utility>
 
 #include "compute.hpp"
@@ -12,26 +17,86 @@
 #include "earnings.hpp"
 #include "accounts.hpp"
 #include "incomes.hpp"
+#include "data.hpp"
+#include "metrics.hpp"
+#include "columns.hpp"
 
-budget::status budget::compute_year_status() {
-    auto today = budget::local_day();
-    return compute_year_status(today.year(), today.month());
+namespace {
+
+enum class status_kind : char {
+    MONTH,
+    YEAR
+};
+
+using status_key = std::tuple<budget::date_type, budget::date_type, status_kind>;
+
+// The statuses only depend on these modules
+const std::vector<std::atomic<size_t>*>& status_generations(){
+    static const std::vector<std::atomic<size_t>*> generations{
+        &budget::module_generation("expenses"),
+        &budget::module_generation("earnings"),
+        &budget::module_generation("accounts"),
+        &budget::module_generation("incomes")};
+
+    return generations;
 }
 
-budget::status budget::compute_year_status(year year) {
-    return compute_year_status(year, 12);
+std::mutex statuses_lock;
+std::vector<size_t> statuses_generations;
+std::map<status_key, budget::status> statuses;
+
+template <typename Functor>
+budget::status memoized_status(status_kind kind, budget::year year, budget::month month, Functor compute){
+    static auto& hits   = budget::register_counter("budget_status_cache_hits_total");
+    static auto& misses = budget::register_counter("budget_status_cache_misses_total");
+
+    // The generations are read first, a concurrent change only causes a recomputation
+    std::vector<size_t> generations;
+    for (auto* generation : status_generations()) {
+        generations.push_back(generation->load());
+    }
+
+    status_key key(year.value, month.value, kind);
+
+    {
+        std::lock_guard<std::mutex> lock(statuses_lock);
+
+        if (generations != statuses_generations) {
+            statuses.clear();
+            statuses_generations = generations;
+        } else {
+            auto it = statuses.find(key);
+
+            if (it != statuses.end()) {
+                hits.increment();
+                return it->second;
+            }
+        }
+    }
+
+    misses.increment();
+
+    auto status = compute();
+
+    std::lock_guard<std::mutex> lock(statuses_lock);
+
+    if (generations == statuses_generations) {
+        statuses[key] = status;
+    }
+
+    return status;
 }
 
-budget::status budget::compute_year_status(year year, month month) {
+budget::status year_status(budget::year year, budget::month month) {
     budget::status status;
 
-    auto sm = start_month(year);
+    auto sm = budget::start_month(year);
 
-    status.expenses = accumulate_amount(all_expenses_between(year, sm, month));
-    status.earnings = accumulate_amount(all_earnings_between(year, sm, month));
+    status.expenses = budget::sum_amounts(*budget::expenses_columns(), budget::column_month(year, sm), budget::column_month(year, month));
+    status.earnings = budget::sum_amounts(*budget::earnings_columns(), budget::column_month(year, sm), budget::column_month(year, month));
 
     for (unsigned short i = sm; i <= month; ++i) {
-        status.budget += accumulate_amount(all_accounts(year, i));
+        status.budget += accumulate_amount(budget::all_accounts(year, i));
     }
 
     status.balance = status.budget + status.earnings - status.expenses;
@@ -39,6 +104,34 @@ budget::status budget::compute_year_status(year year, month month) {
     return status;
 }
 
+budget::status month_status(budget::year year, budget::month month) {
+    budget::status status;
+
+    status.expenses    = budget::sum_amounts(*budget::expenses_columns(), budget::column_month(year, month), budget::column_month(year, month));
+    status.earnings    = budget::sum_amounts(*budget::earnings_columns(), budget::column_month(year, month), budget::column_month(year, month));
+    status.budget      = accumulate_amount(budget::all_accounts(year, month));
+    status.balance     = status.budget + status.earnings - status.expenses;
+    status.base_income = budget::get_base_income(budget::date(year, month, 1));
+    status.income      = status.base_income + status.earnings;
+
+    return status;
+}
+
+} // end of anonymous namespace
+
+budget::status budget::compute_year_status() {
+    auto today = budget::local_day();
+    return compute_year_status(today.year(), today.month());
+}
+
+budget::status budget::compute_year_status(year year) {
+    return compute_year_status(year, 12);
+}
+
+budget::status budget::compute_year_status(year year, month month) {
+    return memoized_status(status_kind::YEAR, year, month, [year, month]() { return year_status(year, month); });
+}
+
 budget::status budget::compute_month_status() {
     auto today = budget::local_day();
     return compute_month_status(today.year(), today.month());
@@ -50,16 +143,7 @@ budget::status budget::compute_month_status(month month) {
 }
 
 budget::status budget::compute_month_status(year year, month month) {
-    budget::status status;
-
-    status.expenses    = accumulate_amount(all_expenses_month(year, month));
-    status.earnings    = accumulate_amount(all_earnings_month(year, month));
-    status.budget      = accumulate_amount(all_accounts(year, month));
-    status.balance     = status.budget + status.earnings - status.expenses;
-    status.base_income = get_base_income(budget::date(year, month, 1));
-    status.income      = status.base_income + status.earnings;
-
-    return status;
+    return memoized_status(status_kind::MONTH, year, month, [year, month]() { return month_status(year, month); });
 }
 
 budget::status budget::compute_avg_month_status() {
@@ -19,6 +19,7 @@
 #endif
 
 #include "config.hpp"
+#include "data.hpp"
 #include "utils.hpp"
 #include "server.hpp"
 
@@ -129,6 +130,8 @@ bool budget::load_config(){
 
     internal_bak = internal;
 
+    bump_generation("config");
+
     //At the first start, the version is not set
     if(internal.find("data_version") == internal.end()){
         internal["data_version"] = budget::to_string(budget::DATA_VERSION);
@@ -141,6 +144,9 @@ void budget::save_config(){
     if(internal != internal_bak){
         save_configuration(path_to_budget_file("config"), internal);
     }
+
+    // The internal configuration may have been changed in place
+    bump_generation("config");
 }
 
 std::string budget::home_folder(){
@@ -181,7 +187,14 @@ bool budget::config_contains(const std::string& key){
 }
 
 std::string budget::config_value(const std::string& key){
-    return configuration[key];
+    // Must not insert, the configuration is read concurrently by the server
+    auto it = configuration.find(key);
+
+    if (it == configuration.end()) {
+        return "";
+    }
+
+    return it->second;
 }
 
 std::string budget::config_value(const std::string& key, const std::string& def){
@@ -244,6 +257,22 @@ size_t budget::get_server_port(){
     return 8080;
 }
 
+std::vector<std::string> budget::get_server_hot_pages(){
+    if (config_contains("server_hot_pages")) {
+        std::vector<std::string> pages;
+
+        for (auto& page : split(config_value("server_hot_pages"), ',')) {
+            if (!page.empty()) {
+                pages.push_back(page);
+            }
+        }
+
+        return pages;
+    }
+
+    return {"/"};
+}
+
 bool budget::is_server_mode(){
     // The server cannot run in server mode
     if (is_server_running()) {
@@ -144,16 +144,10 @@ char getch() {
     return buf;
 }
 
-} // end of anonymous namespace
-
-std::string budget::get_string_complete(const std::vector<std::string>& choices) {
+// Tab completes the answer when a single choice starts with it, the arrows go through the choices
+std::string complete_string(const std::vector<std::string>& choices, const budget::string_completer& completer) {
     std::string answer;
 
-    if (choices.empty()) {
-        std::getline(std::cin, answer);
-        return answer;
-    }
-
     size_t index = 0;
 
     while (true) {
@@ -172,21 +166,16 @@ std::string budget::get_string_complete(const std::vector<std::string>& choices)
             return answer;
         } else if (c == '\t') {
             if (!answer.empty()) {
-                size_t count = 0;
-                std::string valid;
-
-                for (auto& choice : choices) {
-                    if (choice.size() > answer.size()) {
-                        if (choice.substr(0, answer.size()) == answer) {
-                            ++count;
-                            valid = choice;
-                        }
+                auto valid = completer(answer);
+
+                // The completion may differ in case from the answer
+                if (valid.size() == 1 && valid.front().size() > answer.size()) {
+                    for (size_t i = 0; i < answer.size(); ++i) {
+                        std::cout << "\b \b";
                     }
-                }
 
-                if (count == 1) {
-                    std::cout << valid.substr(answer.size(), valid.size());
-                    answer = valid;
+                    answer = valid.front();
+                    std::cout << answer;
                 }
             }
         } else if (c == '\033') {
@@ -194,6 +183,10 @@ std::string budget::get_string_complete(const std::vector<std::string>& choices)
 
             char cc = getch();
 
+            if (choices.empty()) {
+                continue;
+            }
+
             if (cc == 'A') {
                 for (size_t i = 0; i < answer.size(); ++i) {
                     std::cout << "\b \b";
@@ -234,3 +227,30 @@ std::string budget::get_string_complete(const std::vector<std::string>& choices)
 
     return answer;
 }
+
+} // end of anonymous namespace
+
+std::string budget::get_string_complete(const std::vector<std::string>& choices) {
+    if (choices.empty()) {
+        std::string answer;
+        std::getline(std::cin, answer);
+        return answer;
+    }
+
+    return complete_string(choices, [&choices](const std::string& prefix) {
+        std::vector<std::string> valid;
+
+        for (auto& choice : choices) {
+            if (choice.size() > prefix.size() && choice.substr(0, prefix.size()) == prefix) {
+                valid.push_back(choice);
+            }
+        }
+
+        return valid;
+    });
+}
+
+std::string budget::get_string_complete(const string_completer& completer) {
+    // The arrows go through the best choices
+    return complete_string(completer(""), completer);
+}
@@ -5,86 +5,75 @@
 //  http://opensource.org/licenses/MIT)
 //=======================================================================
 
+#include <cstdlib>
+
 #include "cpp_utils/assert.hpp"
 #include "cpp_utils/string.hpp"
 
 #include "writer.hpp"
 #include "console.hpp"
+#include "chunked_buffer.hpp"
 
 namespace {
 
-std::string success_to_string(int success) {
-    std::stringstream ss;
+bool starts_with(const std::string& value, const char* prefix, size_t size){
+    return value.size() >= size && value.compare(0, size, prefix) == 0;
+}
 
+void write_success(std::ostream& os, int success) {
     if (success < 25) {
-        ss << "\033[0;31m";
+        os << "\033[0;31m";
     } else if (success < 75) {
-        ss << "\033[0;33m";
+        os << "\033[0;33m";
     } else if (success < 100) {
-        ss << "\033[0;32m";
+        os << "\033[0;32m";
     } else if (success >= 100) {
-        ss << "\033[1;32m";
+        os << "\033[1;32m";
     }
 
-    budget::print_minimum(ss, success, 5);
-    ss << "%\033[0m  ";
+    budget::print_minimum(os, success, 5);
+    os << "%\033[0m  ";
 
     success     = std::min(success, 109);
     size_t good = success == 0 ? 0 : (success / 10) + 1;
 
     for (size_t i = 0; i < good; ++i) {
-        ss << "\033[1;42m   \033[0m";
+        os << "\033[1;42m   \033[0m";
     }
 
     for (size_t i = good; i < 11; ++i) {
-        ss << "\033[1;41m   \033[0m";
+        os << "\033[1;41m   \033[0m";
     }
-
-    return ss.str();
 }
 
-std::string format(const std::string& v) {
-    if (v.substr(0, 5) == "::red") {
-        auto value = v.substr(5);
-
-        return "\033[0;31m" + value + budget::format_reset();
-    } else if (v.substr(0, 7) == "::green") {
-        auto value = v.substr(7);
-
-        return "\033[0;32m" + value + budget::format_reset();
-    } else if (v.substr(0, 6) == "::blue") {
-        auto value = v.substr(6);
+void write_colored(std::ostream& os, const char* code, const std::string& v, size_t prefix){
+    os << code;
+    os.write(v.data() + prefix, v.size() - prefix);
+    os << budget::format_reset();
+}
 
-        return "\033[0;33m" + value + budget::format_reset();
-    } else if (v.substr(0, 9) == "::success") {
-        auto value   = v.substr(9);
-        auto success = budget::to_number<unsigned long>(value);
-        return success_to_string(success);
+// Write the value, interpreting its formatting prefix, without temporaries
+// Underlined text uses the underlined variant of the colors
+void write_format(std::ostream& os, const std::string& v, bool underline = false) {
+    if (v.size() < 2 || v[0] != ':' || v[1] != ':') {
+        os << v;
+    } else if (starts_with(v, "::red", 5)) {
+        write_colored(os, underline ? "\033[4;31m" : "\033[0;31m", v, 5);
+    } else if (starts_with(v, "::green", 7)) {
+        write_colored(os, underline ? "\033[4;32m" : "\033[0;32m", v, 7);
+    } else if (starts_with(v, "::blue", 6)) {
+        write_colored(os, underline ? "\033[4;33m" : "\033[0;33m", v, 6);
+    } else if (starts_with(v, "::success", 9)) {
+        write_success(os, std::strtoul(v.c_str() + 9, nullptr, 10));
+    } else {
+        os << v;
     }
-
-    return v;
 }
 
-std::string underline_format(const std::string& v) {
-    if (v.substr(0, 5) == "::red") {
-        auto value = v.substr(5);
-
-        return "\033[4;31m" + value + budget::format_reset();
-    } else if (v.substr(0, 7) == "::green") {
-        auto value = v.substr(7);
-
-        return "\033[4;32m" + value + budget::format_reset();
-    } else if (v.substr(0, 6) == "::blue") {
-        auto value = v.substr(6);
-
-        return "\033[4;33m" + value + budget::format_reset();
-    } else if (v.substr(0, 9) == "::success") {
-        auto value   = v.substr(9);
-        auto success = budget::to_number<unsigned long>(value);
-        return success_to_string(success);
+void write_spaces(std::ostream& os, size_t n){
+    for (size_t i = 0; i < n; ++i) {
+        os.put(' ');
     }
-
-    return v;
 }
 
 } // end of anonymous namespace
@@ -93,7 +82,7 @@ budget::console_writer::console_writer(std::ostream& os)
         : os(os) {}
 
 budget::writer& budget::console_writer::operator<<(const std::string& value) {
-    os << format(value);
+    write_format(os, value);
 
     return *this;
 }
@@ -190,10 +179,14 @@ void budget::console_writer::display_table(std::vector<std::string>& columns, st
 
     cpp_assert(columns.size() == 0 || widths.size() == groups * columns.size(), "Widths incorrectly computed");
 
+    // The table is built in memory and written at once
+    budget::chunked_stream out;
+    out.imbue(os.getloc());
+
     // Display the header
 
     if (left) {
-        os << std::string(left, ' ');
+        write_spaces(out, left);
     }
 
     if (columns.empty()) {
@@ -221,23 +214,29 @@ void budget::console_writer::display_table(std::vector<std::string>& columns, st
             //The last space is not underlined
             --width;
 
-            os << format_code(4, 0, 7) << column << (width > rsize(column) ? std::string(width - rsize(column), ' ') : "") << format_code(0, 0, 7);
+            out << format_code(4, 0, 7) << column;
+
+            if (width > rsize(column)) {
+                write_spaces(out, width - rsize(column));
+            }
+
+            out << format_code(0, 0, 7);
 
             //The very last column has no trailing space
 
             if (i < columns.size() - 1) {
-                os << " ";
+                out << " ";
             }
         }
     }
 
-    os << std::endl;
+    out << '\n';
 
     // Display the contents
 
     for (size_t i = 0; i < contents.size(); ++i) {
         if (left) {
-            os << std::string(left, ' ');
+            write_spaces(out, left);
         }
 
         auto& row = contents[i];
@@ -251,21 +250,19 @@ void budget::console_writer::display_table(std::vector<std::string>& columns, st
             for (size_t k = 0; k < groups - 1; ++k) {
                 auto column = j + k;
 
-                std::string value = format(row[column]);
-
                 acc_width += widths[column];
 
                 if (underline) {
-                    os << format_code(4, 0, 7);
-                    os << underline_format(row[column]);
-                    os << std::string(widths[column] - rsize(value) - 1, ' ');
-                    os << format_code(0, 0, 7);
+                    out << format_code(4, 0, 7);
+                    write_format(out, row[column], true);
+                    write_spaces(out, widths[column] - rsize(row[column]) - 1);
+                    out << format_code(0, 0, 7);
                 } else {
-                    os << value;
-                    os << std::string(widths[column] - rsize(value) - 1, ' ');
+                    write_format(out, row[column]);
+                    write_spaces(out, widths[column] - rsize(row[column]) - 1);
                 }
 
-                os << ' ';
+                out << ' ';
             }
 
             //The last column of the group
@@ -282,40 +279,150 @@ void budget::console_writer::display_table(std::vector<std::string>& columns, st
                 --width;
             }
 
-            auto value = format(row[last_column]);
-
             auto missing = width - rsize(row[last_column]);
 
-            std::string fill_string;
-            if (missing > 1) {
-                fill_string = std::string(missing - 1, ' ');
-            }
+            size_t fill = missing > 1 ? missing - 1 : 0;
 
             if (underline) {
-                os << format_code(4, 0, 7);
-                os << underline_format(row[last_column]);
-                os << fill_string;
-                os << format_code(0, 0, 7);
+                out << format_code(4, 0, 7);
+                write_format(out, row[last_column], true);
+                write_spaces(out, fill);
+                out << format_code(0, 0, 7);
             } else {
-                os << value;
-                os << fill_string;
+                write_format(out, row[last_column]);
+                write_spaces(out, fill);
             }
 
             if (missing > 0) {
                 if (j == row.size() - 1 && underline) {
-                    os << format_code(4, 0, 7);
-                    os << ' ';
-                    os << format_code(0, 0, 7);
+                    out << format_code(4, 0, 7);
+                    out << ' ';
+                    out << format_code(0, 0, 7);
                 } else {
-                    os << ' ';
+                    out << ' ';
                 }
             }
         }
 
-        os << format_code(0, 0, 7) << std::endl;
+        out << format_code(0, 0, 7) << '\n';
     }
 
-    os << std::endl;
+    out << '\n';
+
+    out.buffer.for_each_chunk([this](const char* data, size_t size) { os.write(data, size); });
+    os.flush();
+}
+
+void budget::console_writer::display_table(const std::vector<std::string>& columns, const table_row_producer& rows, const std::vector<std::vector<std::string>>& foot, const std::vector<size_t>& max_widths) {
+    cpp_assert(columns.size(), "Streamed tables must have columns");
+
+    // The Edit column is not displayed
+    const size_t C = columns.back() == "Edit" ? columns.size() - 1 : columns.size();
+
+    std::vector<size_t> widths(C, 0);
+
+    // The cells are trimmed like in the materialized tables
+    std::vector<std::string> trimmed(C);
+
+    auto trim = [&trimmed, C](const std::vector<std::string>& row) -> const std::vector<std::string>& {
+        for (size_t i = 0; i < C; ++i) {
+            trimmed[i] = row[i];
+            cpp::trim(trimmed[i]);
+        }
+
+        return trimmed;
+    };
+
+    auto measure = [&widths, &trim, C](const std::vector<std::string>& source) {
+        auto& row = trim(source);
+
+        for (size_t i = 0; i < C; ++i) {
+            widths[i] = std::max(widths[i], rsize(row[i]) + 1);
+        }
+    };
+
+    // Without declared widths, a first pass on the rows computes them
+    if (max_widths.size() >= C) {
+        for (size_t i = 0; i < C; ++i) {
+            widths[i] = max_widths[i] + 1;
+        }
+    } else {
+        rows(measure);
+    }
+
+    for (auto& row : foot) {
+        measure(row);
+    }
+
+    // Display the header
+
+    std::vector<size_t> header_widths;
+
+    for (size_t i = 0; i < C; ++i) {
+        auto& column = columns[i];
+
+        size_t width = std::max(widths[i], rsize(column));
+        header_widths.push_back(width + (i < C - 1 && rsize(column) >= width ? 1 : 0));
+
+        //The last space is not underlined
+        --width;
+
+        os << format_code(4, 0, 7) << column;
+
+        if (width > rsize(column)) {
+            write_spaces(os, width - rsize(column));
+        }
+
+        os << format_code(0, 0, 7);
+
+        //The very last column has no trailing space
+
+        if (i < C - 1) {
+            os << " ";
+        }
+    }
+
+    os << '\n';
+
+    // Display the rows as they are produced
+
+    auto write_row = [this, &widths, &header_widths, &trim, C](const std::vector<std::string>& source) {
+        auto& row = trim(source);
+
+        for (size_t j = 0; j < C; ++j) {
+            size_t width = widths[j];
+
+            //Pad with spaces to fit the header column width
+
+            if (header_widths[j] > width) {
+                width = header_widths[j];
+            } else if (j == C - 1) {
+                --width;
+            }
+
+            auto size = rsize(row[j]);
+
+            write_format(os, row[j]);
+
+            if (width > size) {
+                write_spaces(os, width - size);
+            } else if (j < C - 1) {
+                // A cell larger than the declared width still needs a separator
+                os << ' ';
+            }
+        }
+
+        os << format_code(0, 0, 7) << '\n';
+    };
+
+    rows(write_row);
+
+    for (auto& row : foot) {
+        write_row(row);
+    }
+
+    os << '\n';
+    os.flush();
 }
 
 bool budget::console_writer::is_web() {
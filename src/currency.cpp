@@ -8,6 +8,8 @@
 #include <tuple>
 #include <utility>
 #include <iostream>
+#include <cstdio>
+#include <mutex>
 
 #include "currency.hpp"
 #include "server.hpp"
@@ -15,6 +17,9 @@
 #include "http.hpp"
 #include "date.hpp"
 #include "config.hpp"
+#include "scheduler.hpp"
+#include "data.hpp"
+#include "metrics.hpp"
 
 namespace {
 
@@ -36,13 +41,41 @@ struct currency_cache_key {
 
 std::map<currency_cache_key, double> exchanges;
 
+// The cache file is an append-only log, the last line of a key wins.
+// It is compacted from time to time to drop the superseded lines.
+std::mutex exchanges_lock;
+size_t exchanges_log_lines = 0;
+
+void write_cache_entry(std::ostream& file, const currency_cache_key& key, double rate){
+    file << key.date << ':' << key.from << ':' << key.to << ':' << rate << '\n';
+}
+
+// Must be called with exchanges_lock held
+void append_cache_entry(const currency_cache_key& key, double rate){
+    std::ofstream file(budget::path_to_budget_file("currency.cache"), std::ios::app);
+
+    if (!file.is_open() || !file.good()){
+        std::cout << "ERROR: Impossible to append to Currency Cache" << std::endl;
+        return;
+    }
+
+    file.imbue(std::locale::classic());
+    write_cache_entry(file, key, rate);
+
+    ++exchanges_log_lines;
+}
+
 // V1 is using free.currencyconverterapi.com
 double get_rate_v1(const std::string& from, const std::string& to){
     httplib::Client cli("free.currencyconverterapi.com", 80);
 
     std::string api_complete = "/api/v3/convert?q=" + from + "_" + to + "&compact=ultra";
 
-    auto res = cli.Get(api_complete.c_str());
+    std::shared_ptr<httplib::Response> res;
+    {
+        budget::scoped_duration timer("budget_fetch_duration_seconds", budget::metric_label("service", "currencyconverterapi"));
+        res = cli.Get(api_complete.c_str());
+    }
 
     if (!res) {
         std::cout << "Error accessing exchange rates (no response), setting exchange between " << from << " to " << to << " to 1/1" << std::endl;
@@ -73,7 +106,11 @@ double get_rate_v2(const std::string& from, const std::string& to, const std::st
 
     std::string api_complete = "/" + date + "?symbols=" + to + "&base=" + from;
 
-    auto res = cli.Get(api_complete.c_str());
+    std::shared_ptr<httplib::Response> res;
+    {
+        budget::scoped_duration timer("budget_fetch_duration_seconds", budget::metric_label("service", "exchangeratesapi"));
+        res = cli.Get(api_complete.c_str());
+    }
 
     if (!res) {
         std::cout << "ERROR: Currency(v2): No response, setting exchange between " << from << " to " << to << " to 1/1" << std::endl;
@@ -115,18 +152,31 @@ void budget::load_currency_cache(){
         return;
     }
 
+    std::lock_guard<std::mutex> lock(exchanges_lock);
+
     std::string line;
     while (file.good() && getline(file, line)) {
         if (line.empty()) {
             continue;
         }
 
-        auto parts = split(line, ':');
+        // date:from:to:rate
+        auto first  = line.find(':');
+        auto second = first == std::string::npos ? first : line.find(':', first + 1);
+        auto third  = second == std::string::npos ? second : line.find(':', second + 1);
+
+        if (third == std::string::npos) {
+            continue;
+        }
+
+        currency_cache_key key(line.substr(0, first), line.substr(first + 1, second - first - 1), line.substr(second + 1, third - second - 1));
+        exchanges[key] = budget::parse_double(line.data() + third + 1, line.data() + line.size());
 
-        currency_cache_key key(parts[0], parts[1], parts[2]);
-        exchanges[key] = budget::to_number<double>(parts[3]);
+        ++exchanges_log_lines;
     }
 
+    budget::bump_generation("currency");
+
     if (budget::is_server_running()) {
         std::cout << "INFO: Currency Cache has been loaded from " << file_path << std::endl;
         std::cout << "INFO: Currency Cache has " << exchanges.size() << " entries " << std::endl;
@@ -134,42 +184,84 @@ void budget::load_currency_cache(){
 }
 
 void budget::save_currency_cache() {
-    std::string file_path = budget::path_to_budget_file("currency.cache");
-    std::ofstream file(file_path);
+    std::lock_guard<std::mutex> lock(exchanges_lock);
 
-    if (!file.is_open() || !file.good()){
-        std::cout << "INFO: Impossible to save Currency Cache" << std::endl;
+    size_t valid = 0;
+    for (auto & pair : exchanges) {
+        if (pair.second != 1.0) {
+            ++valid;
+        }
+    }
+
+    // Every entry is already in the log, only rewrite it when it has superseded lines
+    if (exchanges_log_lines == valid) {
         return;
     }
 
-    for (auto & pair : exchanges) {
-        if (pair.second != 1.0) {
-            auto& key = pair.first;
+    std::string file_path = budget::path_to_budget_file("currency.cache");
+    std::string tmp_path  = file_path + ".tmp";
+
+    {
+        std::ofstream file(tmp_path);
 
-            file << key.date << ':' << key.from << ':' << key.to << ':' << pair.second << std::endl;
+        if (!file.is_open() || !file.good()){
+            std::cout << "INFO: Impossible to save Currency Cache" << std::endl;
+            return;
+        }
+
+        file.imbue(std::locale::classic());
+
+        for (auto & pair : exchanges) {
+            if (pair.second != 1.0) {
+                write_cache_entry(file, pair.first, pair.second);
+            }
         }
     }
 
+    std::rename(tmp_path.c_str(), file_path.c_str());
+
     if (budget::is_server_running()) {
-        std::cout << "INFO: Currency Cache has been saved to " << file_path << std::endl;
-        std::cout << "INFO: Currency Cache has " << exchanges.size() << " entries " << std::endl;
+        std::cout << "INFO: Currency Cache has been compacted from " << exchanges_log_lines << " to " << valid << " lines" << std::endl;
     }
+
+    exchanges_log_lines = valid;
 }
 
 void budget::refresh_currency_cache(){
-    // Refresh/Prefetch the current exchange rates
-    for (auto & pair : exchanges) {
-        auto& key = pair.first;
+    std::vector<std::pair<std::string, std::string>> pairs;
+
+    {
+        std::lock_guard<std::mutex> lock(exchanges_lock);
 
-        exchange_rate(key.from, key.to);
+        for (auto & pair : exchanges) {
+            pairs.emplace_back(pair.first.from, pair.first.to);
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    // Refresh/Prefetch the current exchange rates
+    for (auto & pair : pairs) {
+        exchange_rate(pair.first, pair.second);
     }
 
     if (budget::is_server_running()) {
         std::cout << "INFO: Currency Cache has been refreshed" << std::endl;
-        std::cout << "INFO: Currency Cache has " << exchanges.size() << " entries " << std::endl;
+        std::cout << "INFO: Currency Cache has " << pairs.size() << " pairs " << std::endl;
     }
 }
 
+void budget::schedule_currency_jobs(){
+    using namespace std::chrono_literals;
+
+    // Only current day rates are refreshed
+    budget::schedule_job("currency_refresh", 4h, refresh_currency_cache, 4h, 5min);
+
+    // The cache is appended on each fetch, it only needs to be compacted once per day
+    budget::schedule_job("currency_compaction", 24h, save_currency_cache, 24h, 10min);
+}
+
 double budget::exchange_rate(const std::string& from){
     return exchange_rate(from, get_default_currency());
 }
@@ -183,6 +275,9 @@ double budget::exchange_rate(const std::string& from, budget::date d){
 }
 
 double budget::exchange_rate(const std::string& from, const std::string& to, budget::date d){
+    static auto& hits   = budget::register_counter("budget_currency_cache_hits_total");
+    static auto& misses = budget::register_counter("budget_currency_cache_misses_total");
+
     assert(from != "DESIRED" && to != "DESIRED");
 
     if (from == to) {
@@ -192,18 +287,38 @@ double budget::exchange_rate(const std::string& from, const std::string& to, bud
         currency_cache_key key(date_str, from, to);
         currency_cache_key reverse_key(date_str, to, from);
 
-        if (!exchanges.count(key)) {
-            auto rate = get_rate_v2(from, to, date_str);
+        {
+            std::lock_guard<std::mutex> lock(exchanges_lock);
 
-            if (budget::is_server_running()) {
-                std::cout << "INFO: Currency: Rate (" << date_str << ")"
-                          << " from " << from << " to " << to << " = " << rate << std::endl;
+            auto it = exchanges.find(key);
+            if (it != exchanges.end()) {
+                hits.increment();
+                return it->second;
             }
+        }
+
+        misses.increment();
+
+        // The lock is not held during the request
+        auto rate = get_rate_v2(from, to, date_str);
+
+        if (budget::is_server_running()) {
+            std::cout << "INFO: Currency: Rate (" << date_str << ")"
+                      << " from " << from << " to " << to << " = " << rate << std::endl;
+        }
+
+        std::lock_guard<std::mutex> lock(exchanges_lock);
+
+        exchanges[key]         = rate;
+        exchanges[reverse_key] = 1.0 / rate;
+
+        budget::bump_generation("currency");
 
-            exchanges[key]         = rate;
-            exchanges[reverse_key] = 1.0 / rate;
+        if (rate != 1.0) {
+            append_cache_entry(key, rate);
+            append_cache_entry(reverse_key, 1.0 / rate);
         }
 
-        return exchanges[key];
+        return rate;
     }
 }
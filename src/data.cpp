@@ -0,0 +1,36 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <map>
+#include <mutex>
+
+#include "data.hpp"
+
+#include "pages/page_cache.hpp"
+
+std::atomic<size_t>& budget::module_generation(const std::string& module){
+    // Function statics are used since the data handlers are themselves
+    // static and register their module during static initialization
+    static std::mutex lock;
+    static std::map<std::string, std::atomic<size_t>> generations;
+
+    std::lock_guard<std::mutex> l(lock);
+
+    // The elements of a std::map are never moved
+    return generations[module];
+}
+
+void budget::bump_generation(const std::string& module){
+    ++module_generation(module);
+    data_changed();
+}
+
+void budget::data_changed(){
+    if (is_server_running()) {
+        schedule_hot_pages_refresh();
+    }
+}
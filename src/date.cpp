@@ -12,6 +12,7 @@
 #include "config.hpp"
 #include "expenses.hpp"
 #include "earnings.hpp"
+#include "extents.hpp"
 
 budget::date budget::local_day(){
     auto tt = time( NULL );
@@ -45,37 +46,45 @@ std::string budget::date_to_string(budget::date date){
         + "-" + (date.day() < 10 ? "0" : "") + std::to_string(date.day());
 }
 
-unsigned short budget::start_month(budget::year year){
-    budget::month m = 12;
+// The conversions are done based on the proleptic Gregorian calendar,
+// the computations are done on eras of 400 years, starting in March
 
-    for(auto& expense : all_expenses()){
-        if(expense.date.year() == year){
-            m = std::min(expense.date.month(), m);
-        }
-    }
+long budget::day_number(budget::date date){
+    long y     = date.year() - (date.month() <= 2 ? 1 : 0);
+    int m      = date.month();
+    long era   = (y >= 0 ? y : y - 399) / 400;
+    long yoe   = y - era * 400;
+    long doy   = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + date.day() - 1;
+    long doe   = yoe * 365 + yoe / 4 - yoe / 100 + doy;
 
-    for(auto& earning : all_earnings()){
-        if(earning.date.year() == year){
-            m = std::min(earning.date.month(), m);
-        }
-    }
+    return era * 146097 + doe - 719468;
+}
+
+budget::date budget::from_day_number(long day_number){
+    day_number += 719468;
 
-    return m;
+    long era = (day_number >= 0 ? day_number : day_number - 146096) / 146097;
+    long doe = day_number - era * 146097;
+    long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long mp  = (5 * doy + 2) / 153;
+    long d   = doy - (153 * mp + 2) / 5 + 1;
+    long m   = mp < 10 ? mp + 3 : mp - 9;
+    long y   = yoe + era * 400 + (m <= 2 ? 1 : 0);
+
+    return {static_cast<date_type>(y), static_cast<date_type>(m), static_cast<date_type>(d)};
 }
 
-unsigned short budget::start_year(){
-    auto today = budget::local_day();
-    auto y = today.year();
+unsigned short budget::start_month(budget::year year){
+    return std::min(expenses_extent()->first_month(year), earnings_extent()->first_month(year));
+}
 
-    for(auto& expense : all_expenses()){
-        if(expense.date != TEMPLATE_DATE){
-            y = std::min(expense.date.year(), y);
-        }
-    }
+unsigned short budget::start_year(){
+    auto y = budget::local_day().year();
 
-    for(auto& earning : all_earnings()){
-        if(earning.date != TEMPLATE_DATE){
-            y = std::min(earning.date.year(), y);
+    for (auto& extent : {expenses_extent(), earnings_extent()}) {
+        if (!extent->empty) {
+            y = std::min(extent->first.year(), y);
         }
     }
 
@@ -8,6 +8,7 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <unordered_map>
 
 #include "earnings.hpp"
 #include "args.hpp"
@@ -19,6 +20,8 @@
 #include "console.hpp"
 #include "writer.hpp"
 #include "budget_exception.hpp"
+#include "search_index.hpp"
+#include "suggestions.hpp"
 
 using namespace budget;
 
@@ -26,6 +29,45 @@ namespace {
 
 static data_handler<earning> earnings { "earnings", "earnings.data" };
 
+// The names of the previous earnings, the most used first
+std::vector<std::string> complete_earning_name(const std::string& prefix){
+    return suggest_earning_names(prefix);
+}
+
+// Fill the row of the listings for the earning, reusing the storage of the row
+void earning_row(std::vector<std::string>& row, const earning& earning, const std::string& account_name){
+    row.resize(6);
+
+    row[0] = to_string(earning.id);
+    row[1] = to_string(earning.date);
+    row[2] = account_name;
+    row[3] = earning.name;
+    row[4] = to_string(earning.amount);
+    row[5] = "::edit::earnings::" + row[0];
+}
+
+void earning_row(std::vector<std::string>& row, const earning& earning){
+    earning_row(row, earning, get_account(earning.account).name);
+}
+
+// The rows of the results of a search, the name of each account is only searched once
+void earning_search_rows(const table_row_consumer& consumer, const std::vector<size_t>& found){
+    std::unordered_map<size_t, std::string> account_names;
+    std::vector<std::string> row;
+
+    for (auto i : found) {
+        auto& earning = earnings.data[i];
+
+        auto it = account_names.find(earning.account);
+        if (it == account_names.end()) {
+            it = account_names.emplace(earning.account, get_account(earning.account).name).first;
+        }
+
+        earning_row(row, earning, it->second);
+        consumer(row);
+    }
+}
+
 } //end of anonymous namespace
 
 std::map<std::string, std::string> budget::earning::get_params(){
@@ -85,7 +127,7 @@ void budget::earnings_module::handle(const std::vector<std::string>& args){
             edit_string_complete(account_name, "Account", all_account_names(), not_empty_checker(), account_checker(earning.date));
             earning.account = get_account(account_name, earning.date.year(), earning.date.month()).id;
 
-            edit_string(earning.name, "Name", not_empty_checker());
+            edit_string_complete(earning.name, "Name", &complete_earning_name, not_empty_checker());
             edit_money(earning.amount, "Amount", not_negative_checker());
 
             auto id = earnings.add(std::move(earning));
@@ -119,12 +161,20 @@ void budget::earnings_module::handle(const std::vector<std::string>& args){
             edit_string_complete(account_name, "Account", all_account_names(), not_empty_checker(), account_checker(earning.date));
             earning.account = get_account(account_name, earning.date.year(), earning.date.month()).id;
 
-            edit_string(earning.name, "Name", not_empty_checker());
+            edit_string_complete(earning.name, "Name", &complete_earning_name, not_empty_checker());
             edit_money(earning.amount, "Amount", not_negative_checker());
 
             if (earnings.edit(earning)) {
                 std::cout << "Earning " << id << " has been modified" << std::endl;
             }
+        } else if (subcommand == "search") {
+            std::string search;
+            edit_string(search, "Search", not_empty_checker());
+
+            size_t limit = default_search_limit;
+            edit_number(limit, "Limit (0 for all)");
+
+            search_earnings(search, limit, w);
         } else {
             throw budget_exception("Invalid subcommand \"" + subcommand + "\"");
         }
@@ -179,13 +229,54 @@ void budget::show_all_earnings(budget::writer& w){
     w << title_begin << "All Earnings " << add_button("earnings") << title_end;
 
     std::vector<std::string> columns = {"ID", "Date", "Account", "Name", "Amount"};
-    std::vector<std::vector<std::string>> contents;
 
-    for(auto& earning : earnings.data){
-        contents.push_back({to_string(earning.id), to_string(earning.date), get_account(earning.account).name, earning.name, to_string(earning.amount)});
+    w.display_table(columns, [](const table_row_consumer& consumer) {
+        std::vector<std::string> row;
+
+        for (auto& earning : earnings.data) {
+            earning_row(row, earning);
+
+            // This listing has no Edit column
+            row.pop_back();
+
+            consumer(row);
+        }
+    });
+}
+
+void budget::search_earnings(const std::string& search, size_t limit, budget::writer& w){
+    w << title_begin << "Results" << title_end;
+
+    std::vector<std::string> columns = {"ID", "Date", "Account", "Name", "Amount", "Edit"};
+
+    // The total is the one of all the matches, not only of the displayed ones
+    auto found = search_earnings_index(search);
+
+    money total;
+    for(auto i : found){
+        total += earnings.data[i].amount;
     }
 
-    w.display_table(columns, contents);
+    const size_t matches = found.size();
+    const bool truncated = limit && matches > limit;
+
+    if (truncated) {
+        found.resize(limit);
+    }
+
+    if(found.empty()){
+        w << "No earnings found" << end_of_line;
+    } else {
+        auto rows = [&found](const table_row_consumer& consumer) {
+            earning_search_rows(consumer, found);
+        };
+
+        w.display_table(columns, rows, {{"", "", "", "Total", to_string(total), ""}});
+
+        if (truncated) {
+            w << "Only the first " << limit << " of the " << matches << " results are displayed" << end_of_line;
+        }
+    }
 }
 
 void budget::show_earnings(budget::month month, budget::year year, budget::writer& w){
@@ -194,15 +285,12 @@ void budget::show_earnings(budget::month month, budget::year year, budget::write
       << budget::year_month_selector{"earnings", year, month} << title_end;
 
     std::vector<std::string> columns = {"ID", "Date", "Account", "Name", "Amount", "Edit"};
-    std::vector<std::vector<std::string>> contents;
 
     money total;
     size_t count = 0;
 
     for(auto& earning : earnings.data){
         if(earning.date.year() == year && earning.date.month() == month){
-            contents.push_back({to_string(earning.id), to_string(earning.date), get_account(earning.account).name, earning.name, to_string(earning.amount), "::edit::earnings::" + to_string(earning.id)});
-
             total += earning.amount;
             ++count;
         }
@@ -211,9 +299,18 @@ void budget::show_earnings(budget::month month, budget::year year, budget::write
     if(count == 0){
         w << "No earnings for " << month << "-" << year << end_of_line;
     } else {
-        contents.push_back({"", "", "", "Total", to_string(total), ""});
+        auto rows = [month, year](const table_row_consumer& consumer) {
+            std::vector<std::string> row;
+
+            for (auto& earning : earnings.data) {
+                if (earning.date.year() == year && earning.date.month() == month) {
+                    earning_row(row, earning);
+                    consumer(row);
+                }
+            }
+        };
 
-        w.display_table(columns, contents, 1, {}, 0, 1);
+        w.display_table(columns, rows, {{"", "", "", "Total", to_string(total), ""}});
     }
 }
 
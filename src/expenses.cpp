@@ -8,6 +8,7 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <unordered_map>
 
 #include "expenses.hpp"
 #include "args.hpp"
@@ -19,6 +20,8 @@
 #include "console.hpp"
 #include "writer.hpp"
 #include "budget_exception.hpp"
+#include "search_index.hpp"
+#include "suggestions.hpp"
 
 using namespace budget;
 
@@ -47,6 +50,45 @@ void show_templates(){
     }
 }
 
+// The names of the previous expenses, the most used first
+std::vector<std::string> complete_expense_name(const std::string& prefix){
+    return suggest_expense_names(prefix);
+}
+
+// Fill the row of the listings for the expense, reusing the storage of the row
+void expense_row(std::vector<std::string>& row, const expense& expense, const std::string& account_name){
+    row.resize(6);
+
+    row[0] = to_string(expense.id);
+    row[1] = to_string(expense.date);
+    row[2] = account_name;
+    row[3] = expense.name;
+    row[4] = to_string(expense.amount);
+    row[5] = "::edit::expenses::" + row[0];
+}
+
+void expense_row(std::vector<std::string>& row, const expense& expense){
+    expense_row(row, expense, get_account(expense.account).name);
+}
+
+// The rows of the results of a search, the name of each account is only searched once
+void expense_search_rows(const table_row_consumer& consumer, const std::vector<size_t>& found){
+    std::unordered_map<size_t, std::string> account_names;
+    std::vector<std::string> row;
+
+    for (auto i : found) {
+        auto& expense = expenses.data[i];
+
+        auto it = account_names.find(expense.account);
+        if (it == account_names.end()) {
+            it = account_names.emplace(expense.account, get_account(expense.account).name).first;
+        }
+
+        expense_row(row, expense, it->second);
+        consumer(row);
+    }
+}
+
 } //end of anonymous namespace
 
 std::map<std::string, std::string> budget::expense::get_params(){
@@ -164,7 +206,7 @@ void budget::expenses_module::handle(const std::vector<std::string>& args){
                 edit_string_complete(account_name, "Account", all_account_names(), not_empty_checker(), account_checker(expense.date));
                 expense.account = get_account(account_name, expense.date.year(), expense.date.month()).id;
 
-                edit_string(expense.name, "Name", not_empty_checker());
+                edit_string_complete(expense.name, "Name", &complete_expense_name, not_empty_checker());
                 edit_money(expense.amount, "Amount", not_negative_checker(), not_zero_checker());
 
                 auto id = expenses.add(std::move(expense));
@@ -199,7 +241,7 @@ void budget::expenses_module::handle(const std::vector<std::string>& args){
             edit_string_complete(account_name, "Account", all_account_names(), not_empty_checker(), account_checker(expense.date));
             expense.account = get_account(account_name, expense.date.year(), expense.date.month()).id;
 
-            edit_string(expense.name, "Name", not_empty_checker());
+            edit_string_complete(expense.name, "Name", &complete_expense_name, not_empty_checker());
             edit_money(expense.amount, "Amount", not_negative_checker(), not_zero_checker());
 
             if (expenses.edit(expense)) {
@@ -209,7 +251,10 @@ void budget::expenses_module::handle(const std::vector<std::string>& args){
             std::string search;
             edit_string(search, "Search", not_empty_checker());
 
-            search_expenses(search, w);
+            size_t limit = default_search_limit;
+            edit_number(limit, "Limit (0 for all)");
+
+            search_expenses(search, limit, w);
         } else {
             throw budget_exception("Invalid subcommand \"" + subcommand + "\"");
         }
@@ -268,46 +313,49 @@ void budget::show_all_expenses(budget::writer& w){
     w << title_begin << "All Expenses " << add_button("expenses") << title_end;
 
     std::vector<std::string> columns = {"ID", "Date", "Account", "Name", "Amount", "Edit"};
-    std::vector<std::vector<std::string>> contents;
 
-    for(auto& expense : expenses.data){
-        contents.push_back({to_string(expense.id), to_string(expense.date), get_account(expense.account).name,
-            expense.name, to_string(expense.amount), "::edit::expenses::" + to_string(expense.id)});
-    }
+    w.display_table(columns, [](const table_row_consumer& consumer) {
+        std::vector<std::string> row;
 
-    w.display_table(columns, contents);
+        for (auto& expense : expenses.data) {
+            expense_row(row, expense);
+            consumer(row);
+        }
+    });
 }
 
-void budget::search_expenses(const std::string& search, budget::writer& w){
+void budget::search_expenses(const std::string& search, size_t limit, budget::writer& w){
     w << title_begin << "Results" << title_end;
 
     std::vector<std::string> columns = {"ID", "Date", "Account", "Name", "Amount", "Edit"};
-    std::vector<std::vector<std::string>> contents;
 
-    money total;
-    size_t count = 0;
+    // The total is the one of all the matches, not only of the displayed ones
+    auto found = search_expenses_index(search);
 
-    auto l_search = search;
-    std::transform(l_search.begin(), l_search.end(), l_search.begin(), ::tolower);
-
-    for(auto& expense : expenses.data){
-        auto l_name = expense.name;
-        std::transform(l_name.begin(), l_name.end(), l_name.begin(), ::tolower);
+    money total;
+    for(auto i : found){
+        total += expenses.data[i].amount;
+    }
 
-        if(l_name.find(l_search) != std::string::npos){
-            contents.push_back({to_string(expense.id), to_string(expense.date), get_account(expense.account).name, expense.name, to_string(expense.amount), "::edit::expenses::" + to_string(expense.id)});
+    const size_t matches = found.size();
+    const bool truncated = limit && matches > limit;
 
-            total += expense.amount;
-            ++count;
-        }
+    if (truncated) {
+        found.resize(limit);
     }
 
-    if(count == 0){
+    if(found.empty()){
         w << "No expenses found" << end_of_line;
     } else {
-        contents.push_back({"", "", "", "Total", to_string(total), ""});
+        auto rows = [&found](const table_row_consumer& consumer) {
+            expense_search_rows(consumer, found);
+        };
+
+        w.display_table(columns, rows, {{"", "", "", "Total", to_string(total), ""}});
 
-        w.display_table(columns, contents, 1, {}, 0, 1);
+        if (truncated) {
+            w << "Only the first " << limit << " of the " << matches << " results are displayed" << end_of_line;
+        }
     }
 }
 
@@ -317,15 +365,12 @@ void budget::show_expenses(budget::month month, budget::year year, budget::write
       << budget::year_month_selector{"expenses", year, month} << title_end;
 
     std::vector<std::string> columns = {"ID", "Date", "Account", "Name", "Amount", "Edit"};
-    std::vector<std::vector<std::string>> contents;
 
     money total;
     size_t count = 0;
 
     for(auto& expense : expenses.data){
         if(expense.date.year() == year && expense.date.month() == month){
-            contents.push_back({to_string(expense.id), to_string(expense.date), get_account(expense.account).name, expense.name, to_string(expense.amount), "::edit::expenses::" + to_string(expense.id)});
-
             total += expense.amount;
             ++count;
         }
@@ -334,9 +379,18 @@ void budget::show_expenses(budget::month month, budget::year year, budget::write
     if(count == 0){
         w << "No expenses for " << month << "-" << year << end_of_line;
     } else {
-        contents.push_back({"", "", "", "Total", to_string(total), ""});
+        auto rows = [month, year](const table_row_consumer& consumer) {
+            std::vector<std::string> row;
+
+            for (auto& expense : expenses.data) {
+                if (expense.date.year() == year && expense.date.month() == month) {
+                    expense_row(row, expense);
+                    consumer(row);
+                }
+            }
+        };
 
-        w.display_table(columns, contents, 1, {}, 0, 1);
+        w.display_table(columns, rows, {{"", "", "", "Total", to_string(total), ""}});
     }
 }
 
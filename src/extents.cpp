@@ -0,0 +1,76 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include "extents.hpp"
+#include "data.hpp"
+#include "expenses.hpp"
+#include "earnings.hpp"
+
+namespace {
+
+using extent_cache = budget::generation_cache<std::shared_ptr<const budget::data_extent>>;
+
+extent_cache expenses_cache{"expenses"};
+extent_cache earnings_cache{"earnings"};
+
+template <typename Data>
+std::shared_ptr<const budget::data_extent> compute_extent(const Data& data){
+    auto extent = std::make_shared<budget::data_extent>();
+
+    for (auto& entry : data) {
+        if (entry.date == budget::TEMPLATE_DATE) {
+            continue;
+        }
+
+        if (extent->empty) {
+            extent->first = entry.date;
+            extent->last  = entry.date;
+            extent->empty = false;
+        } else {
+            extent->first = std::min(extent->first, entry.date);
+            extent->last  = std::max(extent->last, entry.date);
+        }
+
+        extent->months[entry.date.year()] |= 1 << (entry.date.month() - 1);
+    }
+
+    return extent;
+}
+
+} // end of anonymous namespace
+
+bool budget::data_extent::has_year(budget::year year) const {
+    return months.count(year);
+}
+
+bool budget::data_extent::has_month(budget::year year, budget::month month) const {
+    auto it = months.find(year);
+    return it != months.end() && it->second & (1 << (month - 1));
+}
+
+budget::month budget::data_extent::first_month(budget::year year) const {
+    auto it = months.find(year);
+
+    if (it == months.end()) {
+        return 12;
+    }
+
+    date_type month = 1;
+    while (!(it->second & (1 << (month - 1)))) {
+        ++month;
+    }
+
+    return month;
+}
+
+std::shared_ptr<const budget::data_extent> budget::expenses_extent(){
+    return expenses_cache.get([]() { return compute_extent(all_expenses()); });
+}
+
+std::shared_ptr<const budget::data_extent> budget::earnings_extent(){
+    return earnings_cache.get([]() { return compute_extent(all_earnings()); });
+}
@@ -5,6 +5,9 @@
 //  http://opensource.org/licenses/MIT)
 //=======================================================================
 
+#include <cstdlib>
+#include <iterator>
+
 #include "cpp_utils/assert.hpp"
 #include "cpp_utils/string.hpp"
 
@@ -12,93 +15,153 @@
 #include "console.hpp"
 #include "expenses.hpp"
 #include "earnings.hpp"
+#include "extents.hpp"
+#include "static_assets.hpp"
 
 namespace {
 
-std::string success_to_string(int success) {
+bool starts_with(const std::string& value, const char* prefix, size_t size){
+    return value.size() >= size && value.compare(0, size, prefix) == 0;
+}
+
+void write_success(std::ostream& os, int success) {
     success = std::min(success, 100);
     success = std::max(success, 0);
 
-    std::stringstream ss;
+    os << R"=====(<div class="progress">)=====";
+    os << R"=====(<div class="progress-bar" role="progressbar" style="width:)=====" << success << R"=====(%;" aria-valuenow=")=====" << success << R"=====(" aria-valuemin="0" aria-valuemax="100">)=====" << success << R"=====(%</div>)=====";
+    os << R"=====(</div>)=====";
+}
 
-    ss << R"=====(<div class="progress">)=====";
-    ss << R"=====(<div class="progress-bar" role="progressbar" style="width:)=====" << success << R"=====(%;" aria-valuenow=")=====" << success << R"=====(" aria-valuemin="0" aria-valuemax="100">)=====" << success << R"=====(%</div>)=====";
-    ss << R"=====(</div>)=====";
+void write_edit(std::ostream& os, const char* module, size_t module_size, const char* id, size_t id_size){
+    // Add the delete button
+    os << R"=====(<form class="small-form-inline" method="POST" action="/api/)=====";
+    os.write(module, module_size);
+    os << R"=====(/delete/">)=====";
+    os << R"=====(<input type="hidden" name="server" value="yes">)=====";
+    os << R"=====(<input type="hidden" name="back_page" value="__budget_this_page__">)=====";
+    os << R"=====(<input type="hidden" name="input_id" value=")=====";
+    os.write(id, id_size);
+    os << R"=====(">)=====";
+    os << R"=====(<button type="submit" aria-label="Delete" class="btn btn-sm btn-danger oi oi-circle-x"></button>)=====";
+    os << R"=====(</form>)=====";
 
-    return ss.str();
+    // Add the edit button
+    os << R"=====(<form class="small-form-inline" method="POST" action="/)=====";
+    os.write(module, module_size);
+    os << R"=====(/edit/">)=====";
+    os << R"=====(<input type="hidden" name="server" value="yes">)=====";
+    os << R"=====(<input type="hidden" name="back_page" value="__budget_this_page__">)=====";
+    os << R"=====(<input type="hidden" name="input_id" value=")=====";
+    os.write(id, id_size);
+    os << R"=====(">)=====";
+    os << R"=====(<button type="submit" aria-label="Edit" class="btn btn-sm btn-warning oi oi-pencil"></button>)=====";
+    os << R"=====(</form>)=====";
 }
 
-std::string edit_to_string(const std::string& module, const std::string& id){
-    std::stringstream ss;
+void write_span(std::ostream& os, const char* color, const std::string& v, size_t prefix){
+    os << "<span style=\"color:" << color << ";\">";
+    os.write(v.data() + prefix, v.size() - prefix);
+    os << "</span>";
+}
 
-    // Add the delete button
-    ss << R"=====(<form class="small-form-inline" method="POST" action="/api/)=====";
-    ss << module;
-    ss << R"=====(/delete/">)=====";
-    ss << R"=====(<input type="hidden" name="server" value="yes">)=====";
-    ss << R"=====(<input type="hidden" name="back_page" value="__budget_this_page__">)=====";
-    ss << R"=====(<input type="hidden" name="input_id" value=")=====";
-    ss << id;
-    ss << R"=====(">)=====";
-    ss << R"=====(<button type="submit" aria-label="Delete" class="btn btn-sm btn-danger oi oi-circle-x"></button>)=====";
-    ss << R"=====(</form>)=====";
+// Write the value, interpreting its formatting prefix, without temporaries
+void html_format(budget::html_writer& w, const std::string& v){
+    auto& os = w.os;
+
+    if (v.size() < 2 || v[0] != ':' || v[1] != ':') {
+        os << v;
+    } else if (starts_with(v, "::red", 5)) {
+        write_span(os, "red", v, 5);
+    } else if (starts_with(v, "::blue", 6)) {
+        write_span(os, "blue", v, 6);
+    } else if (starts_with(v, "::green", 7)) {
+        write_span(os, "green", v, 7);
+    } else if (starts_with(v, "::success", 9)) {
+        write_success(os, std::strtoul(v.c_str() + 9, nullptr, 10));
+    } else if (starts_with(v, "::edit::", 8)) {
+        auto separator = v.find("::", 8);
+
+        if (separator == std::string::npos) {
+            os << v;
+        } else {
+            w.use_module("open-iconic");
 
-    // Add the edit button
-    ss << R"=====(<form class="small-form-inline" method="POST" action="/)=====";
-    ss << module;
-    ss << R"=====(/edit/">)=====";
-    ss << R"=====(<input type="hidden" name="server" value="yes">)=====";
-    ss << R"=====(<input type="hidden" name="back_page" value="__budget_this_page__">)=====";
-    ss << R"=====(<input type="hidden" name="input_id" value=")=====";
-    ss << id;
-    ss << R"=====(">)=====";
-    ss << R"=====(<button type="submit" aria-label="Edit" class="btn btn-sm btn-warning oi oi-pencil"></button>)=====";
-    ss << R"=====(</form>)=====";
-
-    return ss.str();
+            write_edit(os, v.data() + 8, separator - 8, v.data() + separator + 2, v.size() - separator - 2);
+        }
+    } else {
+        os << v;
+    }
 }
 
-std::string html_format(budget::html_writer& w, const std::string& v){
-    if(v.substr(0, 5) == "::red"){
-        auto value = v.substr(5);
+// Write the header of a table, with the classes of the special columns
+void write_table_header(std::ostream& os, const std::vector<std::string>& columns, size_t groups, size_t extend, size_t edit){
+    os << "<thead>";
+    os << "<tr>";
+
+    for (size_t i = 0; i < columns.size(); ++i) {
+        auto& column = columns[i];
+
+        if(column == "ID"){
+            continue;
+        }
 
-        return "<span style=\"color:red;\">" + value + "</span>";
-    } else if(v.substr(0, 6) == "::blue"){
-        auto value = v.substr(6);
+        std::string style;
 
-        return "<span style=\"color:blue;\">" + value + "</span>";
-    } else if(v.substr(0, 7) == "::green"){
-        auto value = v.substr(7);
+        // TODO: This is only a bad hack, at best
+        if(i == extend){
+            style = " class=\"extend-only\"";
+        }
 
-        return "<span style=\"color:green;\">" + value + "</span>";
-    } else if(v.substr(0, 9) == "::success"){
-        auto value = v.substr(9);
-        auto success = budget::to_number<unsigned long>(value);
-        return success_to_string(success);
-    } else if(v.substr(0, 8) == "::edit::"){
-        auto value = v.substr(8);
+        if(i == edit){
+            style = " class=\"not-sortable\"";
+        }
 
-        if(value.find("::") == std::string::npos){
-            return v;
+        if (groups > 1) {
+            os << "<th colspan=\"" << groups << "\"" << style << ">" << column << "</th>";
+        } else {
+            os << "<th" << style << ">" << column << "</th>";
         }
+    }
+
+    os << "</tr>";
+    os << "</thead>";
+}
 
-        auto module = value.substr(0, value.find("::"));
-        auto id     = value.substr(value.find("::") + 2, value.size());
+void write_table_row(budget::html_writer& w, const std::vector<std::string>& columns, size_t groups, const std::vector<std::string>& row, bool header_cell){
+    auto& os = w.os;
 
-        w.use_module("open-iconic");
+    os << "<tr>";
 
-        return edit_to_string(module, id);
+    for(size_t j = 0; j < row.size(); ++j){
+        if (columns.size() && groups == 1 && columns[j] == "ID") {
+            continue;
+        }
+
+        if(row[j].empty()){
+            os << "<td>&nbsp;</td>";
+        } else {
+            if(header_cell && columns.empty() && j == 0){
+                os << "<th scope=\"row\">";
+                html_format(w, row[j]);
+                os << "</th>";
+            } else {
+                os << "<td>";
+                html_format(w, row[j]);
+                os << "</td>";
+            }
+        }
     }
 
-    return v;
+    os << "</tr>";
 }
 
 } // end of anonymous namespace
 
-budget::html_writer::html_writer(std::stringstream& os) : os(os) {}
+budget::html_writer::html_writer(std::ostream& os) : os(os) {}
 
 budget::writer& budget::html_writer::operator<<(const std::string& value){
-    os << html_format(*this, value);
+    html_format(*this, value);
 
     return *this;
 }
@@ -168,25 +231,18 @@ budget::writer& budget::html_writer::operator<<(const budget::title_end_t&) {
 }
 
 std::vector<budget::year> active_years(){
-    std::vector<budget::year> years;
+    auto expenses = budget::expenses_extent();
+    auto earnings = budget::earnings_extent();
 
-    for (auto& expense : budget::all_expenses()) {
-        if (expense.date != budget::TEMPLATE_DATE) {
-            auto y = expense.date.year();
+    std::vector<budget::year> years;
 
-            if (std::find(years.begin(), years.end(), y) == years.end()) {
-                years.push_back(y);
-            }
-        }
+    for (auto& year : expenses->months) {
+        years.push_back(year.first);
     }
 
-    for (auto& earning : budget::all_earnings()) {
-        if (earning.date != budget::TEMPLATE_DATE) {
-            auto y = earning.date.year();
-
-            if (std::find(years.begin(), years.end(), y) == years.end()) {
-                years.push_back(y);
-            }
+    for (auto& year : earnings->months) {
+        if (!expenses->has_year(year.first)) {
+            years.push_back(year.first);
         }
     }
 
@@ -380,12 +436,12 @@ void budget::html_writer::display_table(std::vector<std::string>& columns, std::
 
     for (size_t i = 0; i < columns.size(); ++i) {
         for (auto& row : contents) {
-            if (row[i].size() >= 9 && row[i].substr(0, 9) == "::success") {
+            if (starts_with(row[i], "::success", 9)) {
                 extend = i;
                 break;
             }
 
-            if (row[i].size() >= 6 && row[i].substr(0, 6) == "::edit") {
+            if (starts_with(row[i], "::edit", 6)) {
                 edit = i;
                 break;
             }
@@ -411,107 +467,101 @@ void budget::html_writer::display_table(std::vector<std::string>& columns, std::
     // Display the header
 
     if (columns.size()) {
-        os << "<thead>";
-        os << "<tr>";
+        write_table_header(os, columns, groups, extend, edit);
+    }
 
-        for (size_t i = 0; i < columns.size(); ++i) {
-            auto& column = columns[i];
+    // Display the contents
 
-            if(column == "ID"){
-                continue;
-            }
+    os << "<tbody>";
 
-            std::string style;
+    for(size_t i = 0; i < contents.size() - foot; ++i){
+        write_table_row(*this, columns, groups, contents[i], true);
+    }
 
-            // TODO: This is only a bad hack, at best
-            if(i == extend){
-                style = " class=\"extend-only\"";
-            }
+    os << "</tbody>";
 
-            if(i == edit){
-                style = " class=\"not-sortable\"";
-            }
+    if (foot) {
+        os << "<tfoot>";
 
-            if (groups > 1) {
-                os << "<th colspan=\"" << groups << "\"" << style << ">" << column << "</th>";
-            } else {
-                os << "<th" << style << ">" << column << "</th>";
-            }
+        for (size_t i = contents.size() - foot; i < contents.size(); ++i) {
+            write_table_row(*this, columns, groups, contents[i], false);
         }
 
-        os << "</tr>";
-        os << "</thead>";
+        os << "</tfoot>";
     }
 
-    // Display the contents
+    os << "</table>";
 
-    os << "<tbody>";
+    if (small) {
+        os << "</div>"; // middle column
+        os << "<div class=\"col-md-4\">&nbsp;</div>";
+        os << "</div>"; // row
+    } else {
+        os << "</div>"; // table-responsive
+    }
+}
 
-    for(size_t i = 0; i < contents.size() - foot; ++i){
-        auto& row = contents[i];
+void budget::html_writer::display_table(const std::vector<std::string>& columns, const table_row_producer& rows, const std::vector<std::vector<std::string>>& foot, const std::vector<size_t>& widths){
+    cpp_assert(columns.size(), "Streamed tables must have columns");
+    cpp_unused(widths);
 
-        os << "<tr>";
+    os << "<div class=\"table-responsive\">";
+    os << "<table class=\"table table-sm small-text\">";
 
-        for(size_t j = 0; j < row.size(); ++j){
-            if (columns.size() && groups == 1 && columns[j] == "ID") {
-                continue;
-            }
+    // The header is only written with the first row since the special columns
+    // are detected from its cells
 
-            std::string value = html_format(*this, row[j]);
+    bool started = false;
 
-            if(value.empty()){
-                os << "<td>&nbsp;</td>";
-            } else {
-                if(columns.empty() && j == 0){
-                    os << "<th scope=\"row\">" << value << "</th>";
-                } else {
-                    os << "<td>" << value << "</td>";
-                }
+    auto start = [this, &columns, &started](const std::vector<std::string>* first) {
+        size_t extend = columns.size();
+        size_t edit   = columns.size();
+
+        for (size_t i = 0; first && i < columns.size() && i < first->size(); ++i) {
+            if (starts_with((*first)[i], "::success", 9)) {
+                extend = i;
+                break;
+            }
+
+            if (starts_with((*first)[i], "::edit", 6)) {
+                edit = i;
+                break;
             }
         }
 
-        os << "</tr>";
-    }
+        write_table_header(os, columns, 1, extend, edit);
 
-    os << "</tbody>";
+        os << "<tbody>";
 
-    if (foot) {
-        os << "<tfoot>";
+        started = true;
+    };
 
-        for (size_t i = contents.size() - foot; i < contents.size(); ++i) {
-            auto& row = contents[i];
+    rows([this, &columns, &started, &start](const std::vector<std::string>& row) {
+        if (!started) {
+            start(&row);
+        }
 
-            os << "<tr>";
+        write_table_row(*this, columns, 1, row, true);
+    });
 
-            for (size_t j = 0; j < row.size(); ++j) {
-                if (columns.size() && groups == 1 && columns[j] == "ID") {
-                    continue;
-                }
+    if (!started) {
+        start(foot.empty() ? nullptr : &foot.front());
+    }
 
-                std::string value = html_format(*this, row[j]);
+    os << "</tbody>";
 
-                if (value.empty()) {
-                    os << "<td>&nbsp;</td>";
-                } else {
-                    os << "<td>" << value << "</td>";
-                }
-            }
+    if (foot.size()) {
+        os << "<tfoot>";
 
-            os << "</tr>";
+        for (auto& row : foot) {
+            write_table_row(*this, columns, 1, row, false);
         }
 
         os << "</tfoot>";
     }
 
     os << "</table>";
-
-    if (small) {
-        os << "</div>"; // middle column
-        os << "<div class=\"col-md-4\">&nbsp;</div>";
-        os << "</div>"; // row
-    } else {
-        os << "</div>"; // table-responsive
-    }
+    os << "</div>"; // table-responsive
 }
 
 bool budget::html_writer::is_web() {
@@ -573,34 +623,28 @@ void budget::html_writer::defer_script(const std::string& script){
 
 void budget::html_writer::load_deferred_scripts(){
     // The javascript for Boostrap and JQuery
-    os << R"=====(
-            <script src="https://cdnjs.cloudflare.com/ajax/libs/jquery/3.3.1/jquery.slim.min.js" integrity="sha256-3edrmyuQ0w65f8gfBsqowzjJe2iM6n0nKciPUp8y+7E=" crossorigin="anonymous"></script>
-            <script src="https://cdnjs.cloudflare.com/ajax/libs/popper.js/1.13.0/umd/popper.min.js" integrity="sha256-pS96pU17yq+gVu4KBQJi38VpSuKN7otMrDQprzf/DWY=" crossorigin="anonymous"></script>
-            <script src="https://cdnjs.cloudflare.com/ajax/libs/twitter-bootstrap/4.0.0-beta.3/js/bootstrap.min.js" integrity="sha256-JNyuT3QsYBdyeKxKBwnGJAJiACWcow2TjhNruIFFPMQ=" crossorigin="anonymous"></script>
-    )=====";
+    write_asset_tag(os, "jquery/3.3.1/jquery.slim.min.js");
+    write_asset_tag(os, "popper.js/1.13.0/umd/popper.min.js");
+    write_asset_tag(os, "twitter-bootstrap/4.0.0-beta.3/js/bootstrap.min.js");
 
     // Open-Iconic
     if (need_module("open-iconic")) {
-        os << R"=====(<link rel="stylesheet" href="https://cdnjs.cloudflare.com/ajax/libs/open-iconic/1.1.1/font/css/open-iconic-bootstrap.min.css" integrity="sha256-BJ/G+e+y7bQdrYkS2RBTyNfBHpA9IuGaPmf9htub5MQ=" crossorigin="anonymous" />)=====";
+        write_asset_tag(os, "open-iconic/1.1.1/font/css/open-iconic-bootstrap.min.css");
     }
 
     // DataTables
     if (need_module("datatables")) {
-        os << R"=====(
-            <link rel="stylesheet" href="https://cdnjs.cloudflare.com/ajax/libs/datatables/1.10.16/css/dataTables.bootstrap4.min.css" integrity="sha256-LpykTdjMm+jVLpDWiYOkH8bYiithb4gajMYnIngj128=" crossorigin="anonymous" />
-            <script src="https://cdnjs.cloudflare.com/ajax/libs/datatables/1.10.16/js/jquery.dataTables.min.js" integrity="sha256-qcV1wr+bn4NoBtxYqghmy1WIBvxeoe8vQlCowLG+cng=" crossorigin="anonymous"></script>
-            <script src="https://cdnjs.cloudflare.com/ajax/libs/datatables/1.10.16/js/dataTables.bootstrap4.min.js" integrity="sha256-PahDJkda1lmviWgqffy4CcrECIFPJCWoa9EAqVx7Tf8=" crossorigin="anonymous"></script>
-        )=====";
+        write_asset_tag(os, "datatables/1.10.16/css/dataTables.bootstrap4.min.css");
+        write_asset_tag(os, "datatables/1.10.16/js/jquery.dataTables.min.js");
+        write_asset_tag(os, "datatables/1.10.16/js/dataTables.bootstrap4.min.js");
     }
 
     // Highcharts
     if (need_module("highcharts")) {
-        os << R"=====(
-            <script src="https://cdnjs.cloudflare.com/ajax/libs/highcharts/6.0.4/highstock.js" integrity="sha256-ZdoT00QjMb+DdcNmKfZJYcZY6/H83RYoLS4sZRL43T8=" crossorigin="anonymous"></script>
-            <script src="https://cdnjs.cloudflare.com/ajax/libs/highcharts/6.0.4/highcharts-more.js" integrity="sha256-QnoLQZe7BYRVTl3AY8Lsw6mn60HfHZNpcZBEndybfBk=" crossorigin="anonymous"></script>
-            <script src="https://cdnjs.cloudflare.com/ajax/libs/highcharts/6.0.4/js/modules/solid-gauge.js" integrity="sha256-AIfWX+axQ036B1bKbqeWxklZ4BILxbfcNKDh+sqFS+g=" crossorigin="anonymous"></script>
-            <script src="https://cdnjs.cloudflare.com/ajax/libs/highcharts/6.0.4/js/modules/series-label.js" integrity="sha256-58Ca6fVLKQfXdNwnmkcPq09InNJa/Io8EJPJtKXT70g=" crossorigin="anonymous"></script>
-        )=====";
+        write_asset_tag(os, "highcharts/6.0.4/highstock.js");
+        write_asset_tag(os, "highcharts/6.0.4/highcharts-more.js");
+        write_asset_tag(os, "highcharts/6.0.4/js/modules/solid-gauge.js");
+        write_asset_tag(os, "highcharts/6.0.4/js/modules/series-label.js");
     }
 
     // Add the custom scripts
@@ -615,6 +659,17 @@ void budget::html_writer::use_module(const std::string& module){
     }
 }
 
+void budget::html_writer::merge_deferred(budget::html_writer& rhs){
+    for (auto& module : rhs.modules) {
+        use_module(module);
+    }
+
+    std::move(rhs.scripts.begin(), rhs.scripts.end(), std::back_inserter(scripts));
+
+    rhs.scripts.clear();
+    rhs.modules.clear();
+}
+
 bool budget::html_writer::need_module(const std::string& module){
     return std::find(modules.begin(), modules.end(), module) != modules.end();
 }
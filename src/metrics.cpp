@@ -0,0 +1,333 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <map>
+#include <mutex>
+#include <vector>
+#include <sstream>
+
+#include "metrics.hpp"
+#include "scheduler.hpp"
+#include "http.hpp"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+// The upper bounds of the buckets of the histograms, the last bucket is +Inf
+const std::vector<double> duration_buckets{0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0};
+const std::vector<double> size_buckets{256, 1024, 4096, 16384, 65536, 262144, 1048576, 4194304};
+
+struct histogram {
+    const std::vector<double>* bounds = nullptr;
+    std::vector<size_t> buckets; ///< The number of values in each bucket, not cumulative
+    double sum   = 0.0;
+    size_t count = 0;
+
+    void observe(double value){
+        size_t i = 0;
+        while (i < bounds->size() && value > (*bounds)[i]) {
+            ++i;
+        }
+
+        ++buckets[i];
+        sum += value;
+        ++count;
+    }
+
+    // Estimated like Prometheus does, by interpolation in the bucket of the quantile
+    double quantile(double q) const {
+        double rank  = q * count;
+        size_t seen  = 0;
+        double lower = 0.0;
+
+        for (size_t i = 0; i < bounds->size(); ++i) {
+            double upper = (*bounds)[i];
+
+            if (buckets[i] && seen + buckets[i] >= rank) {
+                return lower + (upper - lower) * (rank - seen) / buckets[i];
+            }
+
+            seen += buckets[i];
+            lower = upper;
+        }
+
+        return bounds->back();
+    }
+};
+
+struct metric_family {
+    std::string type;
+    std::map<std::string, double> values;        ///< Counters and gauges, by labels
+    std::map<std::string, budget::counter> counters; ///< Registered counters, by labels
+    std::map<std::string, histogram> histograms; ///< Histograms, by labels
+};
+
+std::mutex metrics_lock;
+std::map<std::string, metric_family> families;
+
+// The request being handled by this thread, completed by finish_request
+struct request_metrics {
+    bool active = false;
+    std::string labels;
+    clock_type::time_point start;
+    size_t streamed = 0;
+};
+
+thread_local request_metrics current_request;
+
+void observe(const std::string& name, const std::string& labels, const std::vector<double>& bounds, double value){
+    std::lock_guard<std::mutex> lock(metrics_lock);
+
+    auto& family = families[name];
+    family.type  = "histogram";
+
+    auto& histogram = family.histograms[labels];
+
+    if (!histogram.bounds) {
+        histogram.bounds = &bounds;
+        histogram.buckets.resize(bounds.size() + 1);
+    }
+
+    histogram.observe(value);
+}
+
+double seconds_since(clock_type::time_point start){
+    return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+std::string with_label(const std::string& labels, const std::string& label){
+    return labels.empty() ? label : labels + "," + label;
+}
+
+void write_sample(std::ostream& os, const std::string& name, const std::string& labels, double value){
+    os << name;
+
+    if (!labels.empty()) {
+        os << '{' << labels << '}';
+    }
+
+    os << ' ' << value << '\n';
+}
+
+void write_family(std::ostream& os, const std::string& name, const metric_family& family){
+    os << "# TYPE " << name << ' ' << family.type << '\n';
+
+    for (auto& value : family.values) {
+        write_sample(os, name, value.first, value.second);
+    }
+
+    for (auto& counter : family.counters) {
+        write_sample(os, name, counter.first, counter.second.value.load(std::memory_order_relaxed));
+    }
+
+    if (family.histograms.empty()) {
+        return;
+    }
+
+    for (auto& pair : family.histograms) {
+        auto& labels    = pair.first;
+        auto& histogram = pair.second;
+
+        size_t cumulative = 0;
+
+        for (size_t i = 0; i < histogram.bounds->size(); ++i) {
+            cumulative += histogram.buckets[i];
+
+            std::stringstream bound;
+            bound.imbue(std::locale::classic());
+            bound.precision(15);
+            bound << (*histogram.bounds)[i];
+
+            write_sample(os, name + "_bucket", with_label(labels, budget::metric_label("le", bound.str())), cumulative);
+        }
+
+        write_sample(os, name + "_bucket", with_label(labels, budget::metric_label("le", "+Inf")), histogram.count);
+        write_sample(os, name + "_sum", labels, histogram.sum);
+        write_sample(os, name + "_count", labels, histogram.count);
+    }
+
+    os << "# TYPE " << name << "_quantile gauge\n";
+
+    for (auto& pair : family.histograms) {
+        if (!pair.second.count) {
+            continue;
+        }
+
+        for (auto q : {"0.5", "0.95", "0.99"}) {
+            write_sample(os, name + "_quantile", with_label(pair.first, budget::metric_label("quantile", q)), pair.second.quantile(std::stod(q)));
+        }
+    }
+}
+
+void write_scheduler_metrics(std::ostream& os){
+    auto jobs = budget::scheduler_metrics();
+
+    os << "# TYPE budget_scheduler_job_runs_total counter\n";
+    for (auto& job : jobs) {
+        write_sample(os, "budget_scheduler_job_runs_total", budget::metric_label("job", job.name), job.runs);
+    }
+
+    os << "# TYPE budget_scheduler_job_failures_total counter\n";
+    for (auto& job : jobs) {
+        write_sample(os, "budget_scheduler_job_failures_total", budget::metric_label("job", job.name), job.failures);
+    }
+
+    os << "# TYPE budget_scheduler_job_overruns_total counter\n";
+    for (auto& job : jobs) {
+        write_sample(os, "budget_scheduler_job_overruns_total", budget::metric_label("job", job.name), job.overruns);
+    }
+
+    os << "# TYPE budget_scheduler_job_last_duration_seconds gauge\n";
+    for (auto& job : jobs) {
+        write_sample(os, "budget_scheduler_job_last_duration_seconds", budget::metric_label("job", job.name), job.last_latency.count() / 1000.0);
+    }
+}
+
+budget::route_handler meter_route(const std::string& method, const std::string& route, budget::route_handler handler){
+    auto labels = budget::metric_label("method", method) + "," + budget::metric_label("route", route);
+
+    return [labels, handler](const httplib::Request& req, httplib::Response& res) {
+        current_request.active   = true;
+        current_request.labels   = labels;
+        current_request.start    = clock_type::now();
+        current_request.streamed = 0;
+
+        // The gauge is decreased even when the handler throws
+        struct in_flight {
+            const std::string& labels;
+
+            explicit in_flight(const std::string& labels) : labels(labels) {
+                budget::add_to_gauge("budget_http_requests_in_flight", labels, 1);
+            }
+
+            ~in_flight() {
+                budget::add_to_gauge("budget_http_requests_in_flight", labels, -1);
+            }
+        } guard(labels);
+
+        handler(req, res);
+    };
+}
+
+} // end of anonymous namespace
+
+std::string budget::metric_label(const std::string& name, const std::string& value){
+    std::string label = name + "=\"";
+
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            label += '\\';
+            label += c;
+        } else if (c == '\n') {
+            label += "\\n";
+        } else {
+            label += c;
+        }
+    }
+
+    label += '"';
+    return label;
+}
+
+void budget::increment_counter(const std::string& name, const std::string& labels, size_t value){
+    std::lock_guard<std::mutex> lock(metrics_lock);
+
+    auto& family = families[name];
+    family.type  = "counter";
+    family.values[labels] += value;
+}
+
+budget::counter& budget::register_counter(const std::string& name, const std::string& labels){
+    std::lock_guard<std::mutex> lock(metrics_lock);
+
+    auto& family = families[name];
+    family.type  = "counter";
+
+    // The nodes of the map are never moved, the reference stays valid
+    return family.counters[labels];
+}
+
+void budget::add_to_gauge(const std::string& name, const std::string& labels, long delta){
+    std::lock_guard<std::mutex> lock(metrics_lock);
+
+    auto& family = families[name];
+    family.type  = "gauge";
+    family.values[labels] += delta;
+}
+
+void budget::observe_duration(const std::string& name, const std::string& labels, double seconds){
+    observe(name, labels, duration_buckets, seconds);
+}
+
+void budget::observe_size(const std::string& name, const std::string& labels, size_t bytes){
+    observe(name, labels, size_buckets, bytes);
+}
+
+budget::scoped_duration::scoped_duration(std::string name, std::string labels) : name(std::move(name)), labels(std::move(labels)), start(clock_type::now()) {
+    // Nothing else to init
+}
+
+budget::scoped_duration::~scoped_duration(){
+    observe_duration(name, labels, seconds_since(start));
+}
+
+std::string budget::metrics_text(){
+    std::stringstream ss;
+    ss.imbue(std::locale::classic());
+    ss.precision(15);
+
+    {
+        std::lock_guard<std::mutex> lock(metrics_lock);
+
+        for (auto& family : families) {
+            write_family(ss, family.first, family.second);
+        }
+    }
+
+    write_scheduler_metrics(ss);
+
+    return ss.str();
+}
+
+budget::metered_server::metered_server(httplib::Server& server) : server(server) {
+    // Nothing else to init
+}
+
+budget::metered_server& budget::metered_server::Get(const char* pattern, route_handler handler){
+    server.Get(pattern, meter_route("GET", pattern, std::move(handler)));
+    return *this;
+}
+
+budget::metered_server& budget::metered_server::Post(const char* pattern, route_handler handler){
+    server.Post(pattern, meter_route("POST", pattern, std::move(handler)));
+    return *this;
+}
+
+void budget::metered_server::set_error_handler(route_handler handler){
+    server.set_error_handler(std::move(handler));
+}
+
+void budget::finish_request(const httplib::Request& req, const httplib::Response& res){
+    // The requests without route are grouped together
+    auto labels = current_request.active ? current_request.labels : metric_label("method", req.method) + "," + metric_label("route", "none");
+
+    // Streamed pages are rendered while they are written, they are measured until the end
+    increment_counter("budget_http_requests_total", with_label(labels, metric_label("status", std::to_string(res.status))));
+    observe_size("budget_http_response_size_bytes", labels, res.body.size() + current_request.streamed);
+
+    if (current_request.active) {
+        observe_duration("budget_http_request_duration_seconds", labels, seconds_since(current_request.start));
+    }
+
+    current_request.active   = false;
+    current_request.streamed = 0;
+}
+
+void budget::record_streamed_bytes(size_t bytes){
+    current_request.streamed += bytes;
+}
@@ -0,0 +1,123 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include "monthly_series.hpp"
+#include "expenses.hpp"
+#include "earnings.hpp"
+#include "accounts.hpp"
+#include "incomes.hpp"
+#include "columns.hpp"
+
+namespace {
+
+budget::monthly_series<budget::money> monthly_amounts(const budget::data_columns& columns, budget::date first, budget::date last){
+    budget::monthly_series<budget::money> series(first, last);
+
+    std::vector<budget::money> buckets(series.size());
+    budget::bucket_amounts(columns, budget::column_month(first.year(), first.month()), buckets);
+
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        series[i] = buckets[i];
+    }
+
+    return series;
+}
+
+std::unordered_map<size_t, budget::monthly_series<budget::money>> monthly_amounts_by_account(const budget::data_columns& columns, budget::date first, budget::date last){
+    std::unordered_map<size_t, budget::monthly_series<budget::money>> series;
+
+    const uint32_t first_month = budget::column_month(first.year(), first.month());
+
+    for (size_t i = 0; i < columns.size(); ++i) {
+        auto it = series.find(columns.accounts[i]);
+
+        if (it == series.end()) {
+            it = series.emplace(columns.accounts[i], budget::monthly_series<budget::money>(first, last)).first;
+        }
+
+        size_t bucket = columns.months[i] - first_month;
+
+        if (bucket < it->second.size()) {
+            it->second[bucket].value += columns.amounts[i];
+        }
+    }
+
+    return series;
+}
+
+} // end of anonymous namespace
+
+budget::date budget::history_start(){
+    auto year = start_year();
+    return {year, start_month(year), 1};
+}
+
+budget::monthly_series<budget::money> budget::monthly_expenses(budget::date first, budget::date last){
+    return monthly_amounts(*expenses_columns(), first, last);
+}
+
+budget::monthly_series<budget::money> budget::monthly_earnings(budget::date first, budget::date last){
+    return monthly_amounts(*earnings_columns(), first, last);
+}
+
+budget::monthly_series<budget::money> budget::monthly_budget(budget::date first, budget::date last){
+    budget::monthly_series<budget::money> series(first, last);
+
+    for (auto& account : all_accounts()) {
+        for (size_t i = 0; i < series.size(); ++i) {
+            // The same test as all_accounts(year, month)
+            auto month = series.month_date(i);
+            budget::date date(month.year(), month.month(), 5);
+
+            if (account.since < date && account.until > date) {
+                series[i] += account.amount;
+            }
+        }
+    }
+
+    return series;
+}
+
+budget::monthly_series<budget::money> budget::monthly_base_income(budget::date first, budget::date last){
+    budget::monthly_series<budget::money> series(first, last);
+
+    for (size_t i = 0; i < series.size(); ++i) {
+        series[i] = get_base_income(series.month_date(i));
+    }
+
+    return series;
+}
+
+std::unordered_map<size_t, budget::monthly_series<budget::money>> budget::monthly_expenses_by_account(budget::date first, budget::date last){
+    return monthly_amounts_by_account(*expenses_columns(), first, last);
+}
+
+std::unordered_map<size_t, budget::monthly_series<budget::money>> budget::monthly_earnings_by_account(budget::date first, budget::date last){
+    return monthly_amounts_by_account(*earnings_columns(), first, last);
+}
+
+budget::monthly_series<budget::status> budget::monthly_status(budget::date first, budget::date last){
+    auto expenses    = monthly_expenses(first, last);
+    auto earnings    = monthly_earnings(first, last);
+    auto budget      = monthly_budget(first, last);
+    auto base_income = monthly_base_income(first, last);
+
+    budget::monthly_series<budget::status> series(first, last);
+
+    for (size_t i = 0; i < series.size(); ++i) {
+        auto& status = series[i];
+
+        status.expenses    = expenses[i];
+        status.earnings    = earnings[i];
+        status.budget      = budget[i];
+        status.balance     = status.budget + status.earnings - status.expenses;
+        status.base_income = base_income[i];
+        status.income      = status.base_income + status.earnings;
+    }
+
+    return series;
+}
@@ -23,82 +23,39 @@
 #include "config.hpp"
 #include "incomes.hpp"
 #include "writer.hpp"
+#include "aggregation_cube.hpp"
+#include "account_timeline.hpp"
+#include "columns.hpp"
 
 using namespace budget;
 
 namespace {
 
+bool invalid_accounts(budget::year year){
+    return accounts_timeline()->changes_between(year, start_month(year), year, 12);
+}
+
 bool invalid_accounts_all(){
+    auto timeline = accounts_timeline();
+
     auto sy = start_year();
+    auto sm = start_month(sy);
 
     auto today = budget::local_day();
 
-    std::vector<budget::account> previous = all_accounts(sy, start_month(sy));
-
-    for(unsigned short j = sy; j <= today.year(); ++j){
-        budget::year year = j;
-
-        auto sm = start_month(year);
-
-        for(unsigned short i = sm; i < 13; ++i){
-            budget::month month = i;
-
-            auto current_accounts = all_accounts(year, month);
-
-            if(current_accounts.size() != previous.size()){
-                return true;
-            }
-
-            for(auto& c : current_accounts){
-                bool found = false;
-
-                for(auto& p : previous){
-                    if(p.name == c.name){
-                        found = true;
-                        break;
-                    }
-                }
-
-                if(!found){
-                    return true;
-                }
-            }
-        }
+    // Without any change, all the months have the same accounts
+    if(!timeline->changes_between(sy, sm, today.year(), 12)){
+        return false;
     }
 
-    return false;
-}
-
-bool invalid_accounts(budget::year year){
-    auto sm = start_month(year);
-
-    std::vector<budget::account> previous = all_accounts(year, sm);;
-
-    for(unsigned short i = sm + 1; i < 13; ++i){
-        budget::month month = i;
+    auto first = timeline->names(sy, sm);
 
-        auto current_accounts = all_accounts(year, month);
+    for(unsigned short j = sy; j <= today.year(); ++j){
+        budget::year year = j;
 
-        if(current_accounts.size() != previous.size()){
+        if(invalid_accounts(year) || timeline->names(year, start_month(year)) != first){
             return true;
         }
-
-        for(auto& c : current_accounts){
-            bool found = false;
-
-            for(auto& p : previous){
-                if(p.name == c.name){
-                    found = true;
-                    break;
-                }
-            }
-
-            if(!found){
-                return true;
-            }
-        }
-
-        previous = std::move(current_accounts);
     }
 
     return false;
@@ -137,6 +94,9 @@ std::vector<budget::money> compute_total_budget(budget::month month, budget::yea
         start_year_report = start_year();
     }
 
+    auto expenses = expenses_columns();
+    auto earnings = earnings_columns();
+
     for(budget::year y = start_year_report; y <= year; y = y + 1){
         budget::month m = start_month(y);
 
@@ -147,8 +107,8 @@ std::vector<budget::money> compute_total_budget(budget::month month, budget::yea
 
             for(auto& account : all_accounts(y, m)){
                 tmp[account.name] += account.amount;
-                tmp[account.name] -= accumulate_amount(all_expenses_month(account.id, y, m));
-                tmp[account.name] += accumulate_amount(all_earnings_month(account.id, y, m));
+                tmp[account.name] -= sum_amounts(*expenses, account.id, column_month(y, m), column_month(y, m));
+                tmp[account.name] += sum_amounts(*earnings, account.id, column_month(y, m), column_month(y, m));
             }
 
             if(y != year && m == 12){
@@ -215,34 +175,29 @@ struct icompare_str {
     }
 };
 
-template<typename Functor>
-void aggregate_overview(budget::writer& w, bool full, bool disable_groups, const std::string& separator, Functor&& func){
+// The slice calls its functor with each cell of the cube to aggregate
+template<typename Slice>
+void aggregate_overview(budget::writer& w, bool full, bool disable_groups, const std::string& separator, const budget::aggregation_cube& cube, Slice&& slice){
     std::unordered_map<std::string, std::unordered_map<std::string, budget::money, icompare_str, icompare_str>> acc_expenses;
 
-    //Accumulate all the expenses
-    for(auto& expense : all_expenses()){
-        if(func(expense)){
-            auto name = expense.name;
+    //Roll up the cells by account and by group
+    slice([&](const budget::cube_key& key, const budget::cube_cell& cell){
+        auto name = cube.label(key.name);
 
-            if(name[name.size() - 1] == ' '){
-                name.erase(name.size() - 1, name.size());
-            }
-
-            if(!disable_groups){
-                auto loc = name.find(separator);
-                if(loc != std::string::npos){
-                    name = name.substr(0, loc);
-                }
+        if(!disable_groups){
+            auto loc = name.find(separator);
+            if(loc != std::string::npos){
+                name = name.substr(0, loc);
             }
+        }
 
-            if(full){
-                acc_expenses["All accounts"][name] += expense.amount;
-            } else {
-                auto& account = get_account(expense.account);
-                acc_expenses[account.name][name] += expense.amount;
-            }
+        if(full){
+            acc_expenses["All accounts"][name] += cell.sum;
+        } else {
+            auto& account = get_account(key.account);
+            acc_expenses[account.name][name] += cell.sum;
         }
-    }
+    });
 
     for (auto& account : current_accounts()) {
         auto it = acc_expenses.find(account.name);
@@ -647,6 +602,9 @@ void budget::display_local_balance(budget::writer& w, budget::year year, bool cu
     std::unordered_map<std::string, budget::money> account_totals;
     std::unordered_map<std::string, budget::money> account_current_totals;
 
+    auto expenses = expenses_columns();
+    auto earnings = earnings_columns();
+
     //Prepare the rows
 
     for(auto& account : all_accounts(year, sm)){
@@ -668,8 +626,8 @@ void budget::display_local_balance(budget::writer& w, budget::year year, bool cu
                 total_expenses = accumulate_amount_if(all_expenses(), [account,year,m](const budget::expense& e){return get_account(e.account).name == account.name && e.date.year() == year && e.date.month() == m;});
                 total_earnings = accumulate_amount_if(all_earnings(), [account,year,m](const budget::earning& e){return get_account(e.account).name == account.name && e.date.year() == year && e.date.month() == m;});
             } else {
-                total_expenses = accumulate_amount_if(all_expenses(), [account,year,m](const budget::expense& e){return e.account == account.id && e.date.year() == year && e.date.month() == m;});
-                total_earnings = accumulate_amount_if(all_earnings(), [account,year,m](const budget::earning& e){return e.account == account.id && e.date.year() == year && e.date.month() == m;});
+                total_expenses = sum_amounts(*expenses, account.id, column_month(year, m), column_month(year, m));
+                total_earnings = sum_amounts(*earnings, account.id, column_month(year, m), column_month(year, m));
             }
 
             auto month_total = account.amount - total_expenses + total_earnings;
@@ -838,6 +796,9 @@ void budget::display_balance(budget::writer& w, budget::year year, bool relaxed,
         }
     }
 
+    auto expenses = expenses_columns();
+    auto earnings = earnings_columns();
+
     //Fill the table
 
     for(unsigned short i = sm; i <= 12; ++i){
@@ -851,8 +812,8 @@ void budget::display_balance(budget::writer& w, budget::year year, bool relaxed,
                 total_expenses = accumulate_amount_if(all_expenses(), [account,year,m](const budget::expense& e){return get_account(e.account).name == account.name && e.date.year() == year && e.date.month() == m;});
                 total_earnings = accumulate_amount_if(all_earnings(), [account,year,m](const budget::earning& e){return get_account(e.account).name == account.name && e.date.year() == year && e.date.month() == m;});
             } else {
-                total_expenses = accumulate_amount_if(all_expenses(), [account,year,m](const budget::expense& e){return e.account == account.id && e.date.year() == year && e.date.month() == m;});
-                total_earnings = accumulate_amount_if(all_earnings(), [account,year,m](const budget::earning& e){return e.account == account.id && e.date.year() == year && e.date.month() == m;});
+                total_expenses = sum_amounts(*expenses, account.id, column_month(year, m), column_month(year, m));
+                total_earnings = sum_amounts(*earnings, account.id, column_month(year, m), column_month(year, m));
             }
 
             auto month_total = account_previous[account.name][i - 1] + account.amount - total_expenses + total_earnings;
@@ -1006,7 +967,9 @@ void budget::aggregate_all_overview(budget::writer& w, bool full, bool disable_g
 
     w << title_begin << "Aggregate overview of all time" << title_end;
 
-    aggregate_overview(w, full, disable_groups, separator, [](const budget::expense& /*expense*/){ return true; });
+    auto cube = expenses_cube();
+
+    aggregate_overview(w, full, disable_groups, separator, *cube, [&cube](auto functor){ cube->for_each_cell(functor); });
 }
 
 void budget::aggregate_year_overview(budget::writer& w, bool full, bool disable_groups, const std::string& separator, budget::year year){
@@ -1016,11 +979,15 @@ void budget::aggregate_year_overview(budget::writer& w, bool full, bool disable_
 
     w << title_begin << "Aggregate overview of " << year << year_selector{"overview/aggregate/year", year} << title_end;
 
-    aggregate_overview(w, full, disable_groups, separator, [year](const budget::expense& expense){ return expense.date.year() == year; });
+    auto cube = expenses_cube();
+
+    aggregate_overview(w, full, disable_groups, separator, *cube, [&cube, year](auto functor){ cube->for_each_cell(year, functor); });
 }
 
 void budget::aggregate_month_overview(budget::writer& w, bool full, bool disable_groups, const std::string& separator, budget::month month, budget::year year){
     w << title_begin << "Aggregate overview of " << month << " " << year << year_month_selector{"overview/aggregate/month", year, month} << title_end;
 
-    aggregate_overview(w, full, disable_groups, separator, [month,year](const budget::expense& expense){ return expense.date.month() == month && expense.date.year() == year; });
+    auto cube = expenses_cube();
+
+    aggregate_overview(w, full, disable_groups, separator, *cube, [&cube, month, year](auto functor){ cube->for_each_cell(year, month, functor); });
 }
@@ -14,7 +14,7 @@
 using namespace budget;
 
 void budget::accounts_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Accounts")) {
         return;
     }
@@ -28,7 +28,7 @@ void budget::accounts_page(const httplib::Request& req, httplib::Response& res)
 }
 
 void budget::all_accounts_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "All Accounts")) {
         return;
     }
@@ -42,7 +42,7 @@ void budget::all_accounts_page(const httplib::Request& req, httplib::Response& r
 }
 
 void budget::add_accounts_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "New account")) {
         return;
     }
@@ -62,7 +62,7 @@ void budget::add_accounts_page(const httplib::Request& req, httplib::Response& r
 }
 
 void budget::edit_accounts_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Edit account")) {
         return;
     }
@@ -96,7 +96,7 @@ void budget::edit_accounts_page(const httplib::Request& req, httplib::Response&
 }
 
 void budget::archive_accounts_month_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Archive accounts from the beginning of the month")) {
         return;
     }
@@ -115,7 +115,7 @@ void budget::archive_accounts_month_page(const httplib::Request& req, httplib::R
 }
 
 void budget::archive_accounts_year_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Archive accounts from the beginning of the year")) {
         return;
     }
@@ -16,7 +16,7 @@
 using namespace budget;
 
 void budget::list_asset_shares_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "List asset shares")) {
         return;
     }
@@ -30,7 +30,7 @@ void budget::list_asset_shares_page(const httplib::Request& req, httplib::Respon
 }
 
 void budget::add_asset_shares_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "New asset share")) {
         return;
     }
@@ -52,7 +52,7 @@ void budget::add_asset_shares_page(const httplib::Request& req, httplib::Respons
 }
 
 void budget::edit_asset_shares_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
 
     if (!page_get_start(req, res, content_stream, "Edit asset share", {"input_id", "back_page"})){
         return;
@@ -16,21 +16,24 @@
 using namespace budget;
 
 void budget::list_asset_values_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "List asset values")) {
         return;
     }
 
     budget::html_writer w(content_stream);
-    budget::list_asset_values(w);
 
-    make_tables_sortable(w);
+    if (all_asset_values().empty()) {
+        w << "No asset values" << end_of_line;
+    } else {
+        server_side_table(w, "asset_values_table", "/api/asset_values/table/", {"Asset", "Amount", "Date", "Edit"}, 2, true);
+    }
 
     page_end(w, req, res);
 }
 
 void budget::add_asset_values_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "New asset value")) {
         return;
     }
@@ -51,7 +54,7 @@ void budget::add_asset_values_page(const httplib::Request& req, httplib::Respons
 }
 
 void budget::edit_asset_values_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
 
     if (!page_get_start(req, res, content_stream, "Edit asset value", {"input_id", "back_page"})){
         return;
@@ -83,7 +86,7 @@ void budget::edit_asset_values_page(const httplib::Request& req, httplib::Respon
 }
 
 void budget::full_batch_asset_values_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Batch update asset values")) {
         return;
     }
@@ -115,7 +118,7 @@ void budget::full_batch_asset_values_page(const httplib::Request& req, httplib::
 }
 
 void budget::current_batch_asset_values_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Batch update asset values")) {
         return;
     }
@@ -32,7 +32,7 @@ void add_share_based_picker(budget::writer& w, bool share_based) {
 } // namespace
 
 void budget::assets_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Assets")) {
         return;
     }
@@ -46,7 +46,7 @@ void budget::assets_page(const httplib::Request& req, httplib::Response& res) {
 }
 
 void budget::add_assets_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "New asset")) {
         return;
     }
@@ -74,7 +74,7 @@ void budget::add_assets_page(const httplib::Request& req, httplib::Response& res
 }
 
 void budget::edit_assets_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Edit asset")) {
         return;
     }
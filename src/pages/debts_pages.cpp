@@ -43,7 +43,7 @@ void add_direction_picker(budget::writer& w, const std::string& default_value =
 } // end of anonymous namespace
 
 void budget::list_debts_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Debts")) {
         return;
     }
@@ -57,21 +57,22 @@ void budget::list_debts_page(const httplib::Request& req, httplib::Response& res
 }
 
 void budget::all_debts_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "All Debts")) {
         return;
     }
 
     budget::html_writer w(content_stream);
-    budget::display_all_debts(w);
 
-    make_tables_sortable(w);
+    w << title_begin << "All debts " << add_button("debts") << title_end;
+
+    server_side_table(w, "debts_table", "/api/debts/table/", {"Direction", "Name", "Amount", "Paid", "Title", "Edit"}, 2, false);
 
     page_end(w, req, res);
 }
 
 void budget::add_debts_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "New Debt")) {
         return;
     }
@@ -93,7 +94,7 @@ void budget::add_debts_page(const httplib::Request& req, httplib::Response& res)
 }
 
 void budget::edit_debts_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
 
     if (!page_get_start(req, res, content_stream, "Edit Debt", {"input_id", "back_page"})) {
         return;
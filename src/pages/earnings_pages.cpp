@@ -6,16 +6,17 @@
 //=======================================================================
 
 #include <numeric>
-#include <array>
 
 #include "accounts.hpp"
 #include "earnings.hpp"
 #include "incomes.hpp"
+#include "monthly_series.hpp"
 
 #include "writer.hpp"
 #include "pages/earnings_pages.hpp"
 #include "http.hpp"
 #include "config.hpp"
+#include "search_index.hpp"
 
 using namespace budget;
 
@@ -96,7 +97,7 @@ void budget::month_breakdown_income_graph(budget::html_writer& w, const std::str
 
 
 void budget::time_graph_income_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Income over time")) {
         return;
     }
@@ -114,43 +115,21 @@ void budget::time_graph_income_page(const httplib::Request& req, httplib::Respon
     ss << "{ name: 'Monthly income',";
     ss << "data: [";
 
-    std::vector<budget::money> serie;
-    std::vector<std::string> dates;
+    auto first = history_start();
+    auto last  = budget::local_day();
 
-    auto sy = start_year();
+    // The income is the budget of the accounts plus the earnings
+    auto serie    = monthly_budget(first, last);
+    auto earnings = monthly_earnings(first, last);
 
-    for(unsigned short j = sy; j <= budget::local_day().year(); ++j){
-        budget::year year = j;
-
-        auto sm = start_month(year);
-        auto last = 13;
-
-        if(year == budget::local_day().year()){
-            last = budget::local_day().month() + 1;
-        }
-
-        for(unsigned short i = sm; i < last; ++i){
-            budget::month month = i;
-
-            budget::money sum;
-
-            for(auto& account : all_accounts(year, month)){
-                sum += account.amount;
-            }
-
-            for(auto& earning : all_earnings()){
-                if(earning.date.year() == year && earning.date.month() == month){
-                    sum += earning.amount;
-                }
-            }
-
-            std::string date = "Date.UTC(" + std::to_string(year) + "," + std::to_string(month.value - 1) + ", 1)";
+    for (size_t i = 0; i < serie.size(); ++i) {
+        serie[i] += earnings[i];
+    }
 
-            serie.push_back(sum);
-            dates.push_back(date);
+    auto average = rolling_average(serie, 12);
 
-            ss << "[" << date <<  "," << budget::to_flat_string(sum) << "],";
-        }
+    for (size_t i = 0; i < serie.size(); ++i) {
+        ss << "[" << chart_date(serie.month_date(i)) << "," << budget::to_flat_string(serie[i]) << "],";
     }
 
     ss << "]},";
@@ -158,20 +137,8 @@ void budget::time_graph_income_page(const httplib::Request& req, httplib::Respon
     ss << "{ name: '12 months average',";
     ss << "data: [";
 
-    std::array<budget::money, 12> average_12;
-
-    for(size_t i = 0; i < serie.size(); ++i){
-        average_12[i % 12] = serie[i];
-
-        auto average = std::accumulate(average_12.begin(), average_12.end(), budget::money());
-
-        if(i < 12){
-            average = average / int(i + 1);
-        } else {
-            average = average / 12;
-        }
-
-        ss << "[" << dates[i] << "," << budget::to_flat_string(average) << "],";
+    for (size_t i = 0; i < average.size(); ++i) {
+        ss << "[" << chart_date(average.month_date(i)) << "," << budget::to_flat_string(average[i]) << "],";
     }
 
     ss << "]},";
@@ -184,7 +151,7 @@ void budget::time_graph_income_page(const httplib::Request& req, httplib::Respon
 }
 
 void budget::time_graph_earnings_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Earnings over time")) {
         return;
     }
@@ -202,31 +169,10 @@ void budget::time_graph_earnings_page(const httplib::Request& req, httplib::Resp
     ss << "{ name: 'Monthly earnings',";
     ss << "data: [";
 
-    auto sy = start_year();
-
-    for(unsigned short j = sy; j <= budget::local_day().year(); ++j){
-        budget::year year = j;
-
-        auto sm = start_month(year);
-        auto last = 13;
-
-        if(year == budget::local_day().year()){
-            last = budget::local_day().month() + 1;
-        }
-
-        for(unsigned short i = sm; i < last; ++i){
-            budget::month month = i;
-
-            budget::money sum;
+    auto serie = monthly_earnings(history_start(), budget::local_day());
 
-            for(auto& earning : all_earnings()){
-                if(earning.date.year() == year && earning.date.month() == month){
-                    sum += earning.amount;
-                }
-            }
-
-            ss << "[Date.UTC(" << year << "," << month.value - 1 << ", 1) ," << budget::to_flat_string(sum) << "],";
-        }
+    for (size_t i = 0; i < serie.size(); ++i) {
+        ss << "[" << chart_date(serie.month_date(i)) << "," << budget::to_flat_string(serie[i]) << "],";
     }
 
     ss << "]},";
@@ -239,7 +185,7 @@ void budget::time_graph_earnings_page(const httplib::Request& req, httplib::Resp
 }
 
 void budget::add_earnings_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "New earning")) {
         return;
     }
@@ -251,7 +197,7 @@ void budget::add_earnings_page(const httplib::Request& req, httplib::Response& r
     form_begin(w, "/api/earnings/add/", "/earnings/add/");
 
     add_date_picker(w);
-    add_name_picker(w);
+    add_suggested_name_picker(w, "/api/earnings/suggest/");
     add_amount_picker(w);
 
     std::string account;
@@ -273,7 +219,7 @@ void budget::add_earnings_page(const httplib::Request& req, httplib::Response& r
 }
 
 void budget::edit_earnings_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Edit earning")) {
         return;
     }
@@ -297,7 +243,7 @@ void budget::edit_earnings_page(const httplib::Request& req, httplib::Response&
             auto& earning = earning_get(budget::to_number<size_t>(input_id));
 
             add_date_picker(w, budget::to_string(earning.date));
-            add_name_picker(w, earning.name);
+            add_suggested_name_picker(w, "/api/earnings/suggest/", earning.name);
             add_amount_picker(w, budget::to_flat_string(earning.amount));
             add_account_picker(w, earning.date, budget::to_string(earning.account));
 
@@ -309,7 +255,7 @@ void budget::edit_earnings_page(const httplib::Request& req, httplib::Response&
 }
 
 void budget::earnings_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Earnings")) {
         return;
     }
@@ -328,13 +274,42 @@ void budget::earnings_page(const httplib::Request& req, httplib::Response& res)
 }
 
 void budget::all_earnings_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "All Earnings")) {
         return;
     }
 
     budget::html_writer w(content_stream);
-    budget::show_all_earnings(w);
+
+    w << title_begin << "All Earnings " << add_button("earnings") << title_end;
+
+    server_side_table(w, "earnings_table", "/api/earnings/table/", {"Date", "Account", "Name", "Amount", "Edit"}, 0, true);
+
+    page_end(w, req, res);
+}
+
+void budget::search_earnings_page(const httplib::Request& req, httplib::Response& res) {
+    budget::chunked_stream content_stream;
+    if (!page_start(req, res, content_stream, "Search Earnings")) {
+        return;
+    }
+
+    budget::html_writer w(content_stream);
+
+    page_form_begin(w, "/earnings/search/");
+
+    auto limit = get_search_limit(req);
+
+    add_name_picker(w);
+    add_integer_picker(w, "limit", "input_limit", budget::to_string(limit));
+
+    form_end(w);
+
+    if(req.has_param("input_name")){
+        auto search = req.get_param_value("input_name");
+
+        search_earnings(search, limit, w);
+    }
 
     make_tables_sortable(w);
 
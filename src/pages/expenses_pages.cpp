@@ -9,13 +9,14 @@
 
 #include "accounts.hpp"
 #include "expenses.hpp"
+#include "monthly_series.hpp"
 
 #include "writer.hpp"
 #include "pages/expenses_pages.hpp"
 #include "http.hpp"
 #include "config.hpp"
+#include "search_index.hpp"
 
-#include <array>
 
 using namespace budget;
 
@@ -89,7 +90,7 @@ void budget::month_breakdown_expenses_graph(budget::html_writer& w, const std::s
 
 
 void budget::expenses_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Expenses")) {
         return;
     }
@@ -108,7 +109,7 @@ void budget::expenses_page(const httplib::Request& req, httplib::Response& res)
 }
 
 void budget::search_expenses_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Search Expenses")) {
         return;
     }
@@ -117,14 +118,17 @@ void budget::search_expenses_page(const httplib::Request& req, httplib::Response
 
     page_form_begin(w, "/expenses/search/");
 
+    auto limit = get_search_limit(req);
+
     add_name_picker(w);
+    add_integer_picker(w, "limit", "input_limit", budget::to_string(limit));
 
     form_end(w);
 
     if(req.has_param("input_name")){
         auto search = req.get_param_value("input_name");
 
-        search_expenses(search, w);
+        search_expenses(search, limit, w);
     }
 
     make_tables_sortable(w);
@@ -133,7 +137,7 @@ void budget::search_expenses_page(const httplib::Request& req, httplib::Response
 }
 
 void budget::time_graph_expenses_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Expenses over time")) {
         return;
     }
@@ -151,39 +155,11 @@ void budget::time_graph_expenses_page(const httplib::Request& req, httplib::Resp
     ss << "{ name: 'Monthly expenses',";
     ss << "data: [";
 
-    std::vector<budget::money> serie;
-    std::vector<std::string> dates;
-
-    auto sy = start_year();
-
-    for(unsigned short j = sy; j <= budget::local_day().year(); ++j){
-        budget::year year = j;
-
-        auto sm = start_month(year);
-        auto last = 13;
-
-        if(year == budget::local_day().year()){
-            last = budget::local_day().month() + 1;
-        }
-
-        for(unsigned short i = sm; i < last; ++i){
-            budget::month month = i;
-
-            budget::money sum;
-
-            for(auto& expense : all_expenses()){
-                if(expense.date.year() == year && expense.date.month() == month){
-                    sum += expense.amount;
-                }
-            }
-
-            std::string date = "Date.UTC(" + std::to_string(year) + "," + std::to_string(month.value - 1) + ", 1)";
+    auto serie   = monthly_expenses(history_start(), budget::local_day());
+    auto average = rolling_average(serie, 12);
 
-            serie.push_back(sum);
-            dates.push_back(date);
-
-            ss << "[" << date <<  "," << budget::to_flat_string(sum) << "],";
-        }
+    for (size_t i = 0; i < serie.size(); ++i) {
+        ss << "[" << chart_date(serie.month_date(i)) << "," << budget::to_flat_string(serie[i]) << "],";
     }
 
     ss << "]},";
@@ -191,20 +167,8 @@ void budget::time_graph_expenses_page(const httplib::Request& req, httplib::Resp
     ss << "{ name: '12 months average',";
     ss << "data: [";
 
-    std::array<budget::money, 12> average_12;
-
-    for(size_t i = 0; i < serie.size(); ++i){
-        average_12[i % 12] = serie[i];
-
-        auto average = std::accumulate(average_12.begin(), average_12.end(), budget::money());
-
-        if(i < 12){
-            average = average / int(i + 1);
-        } else {
-            average = average / 12;
-        }
-
-        ss << "[" << dates[i] << "," << budget::to_flat_string(average) << "],";
+    for (size_t i = 0; i < average.size(); ++i) {
+        ss << "[" << chart_date(average.month_date(i)) << "," << budget::to_flat_string(average[i]) << "],";
     }
 
     ss << "]},";
@@ -217,21 +181,22 @@ void budget::time_graph_expenses_page(const httplib::Request& req, httplib::Resp
 }
 
 void budget::all_expenses_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "All Expenses")) {
         return;
     }
 
     budget::html_writer w(content_stream);
-    budget::show_all_expenses(w);
 
-    make_tables_sortable(w);
+    w << title_begin << "All Expenses " << add_button("expenses") << title_end;
+
+    server_side_table(w, "expenses_table", "/api/expenses/table/", {"Date", "Account", "Name", "Amount", "Edit"}, 0, true);
 
     page_end(w, req, res);
 }
 
 void budget::month_breakdown_expenses_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Expenses Breakdown")) {
         return;
     }
@@ -256,7 +221,7 @@ void budget::month_breakdown_expenses_page(const httplib::Request& req, httplib:
 }
 
 void budget::year_breakdown_expenses_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Expenses Breakdown")) {
         return;
     }
@@ -308,7 +273,7 @@ void budget::year_breakdown_expenses_page(const httplib::Request& req, httplib::
 }
 
 void budget::add_expenses_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "New Expense")) {
         return;
     }
@@ -320,7 +285,7 @@ void budget::add_expenses_page(const httplib::Request& req, httplib::Response& r
     form_begin(w, "/api/expenses/add/", "/expenses/add/");
 
     add_date_picker(w);
-    add_name_picker(w);
+    add_suggested_name_picker(w, "/api/expenses/suggest/");
     add_amount_picker(w);
 
     std::string account;
@@ -342,7 +307,7 @@ void budget::add_expenses_page(const httplib::Request& req, httplib::Response& r
 }
 
 void budget::edit_expenses_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Edit Expense")) {
         return;
     }
@@ -366,7 +331,7 @@ void budget::edit_expenses_page(const httplib::Request& req, httplib::Response&
             auto& expense = expense_get(budget::to_number<size_t>(input_id));
 
             add_date_picker(w, budget::to_string(expense.date));
-            add_name_picker(w, expense.name);
+            add_suggested_name_picker(w, "/api/expenses/suggest/", expense.name);
             add_amount_picker(w, budget::to_flat_string(expense.amount));
             add_account_picker(w, expense.date, budget::to_string(expense.account));
 
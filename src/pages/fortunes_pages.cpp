@@ -14,7 +14,7 @@
 using namespace budget;
 
 void budget::list_fortunes_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Objectives List")) {
         return;
     }
@@ -28,7 +28,7 @@ void budget::list_fortunes_page(const httplib::Request& req, httplib::Response&
 }
 
 void budget::graph_fortunes_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Fortune")) {
         return;
     }
@@ -66,7 +66,7 @@ void budget::graph_fortunes_page(const httplib::Request& req, httplib::Response&
 }
 
 void budget::status_fortunes_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Objectives Status")) {
         return;
     }
@@ -80,7 +80,7 @@ void budget::status_fortunes_page(const httplib::Request& req, httplib::Response
 }
 
 void budget::add_fortunes_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "New fortune")) {
         return;
     }
@@ -100,7 +100,7 @@ void budget::add_fortunes_page(const httplib::Request& req, httplib::Response& r
 }
 
 void budget::edit_fortunes_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
 
     if (!page_get_start(req, res, content_stream, "Edit Fortune", {"input_id", "back_page"})){
         return;
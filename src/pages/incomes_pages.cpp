@@ -14,7 +14,7 @@
 using namespace budget;
 
 void budget::incomes_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "All Incomes")) {
         return;
     }
@@ -28,7 +28,7 @@ void budget::incomes_page(const httplib::Request& req, httplib::Response& res) {
 }
 
 void budget::set_incomes_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Set income")) {
         return;
     }
@@ -18,6 +18,7 @@
 #include "assets.hpp"
 #include "earnings.hpp"
 #include "expenses.hpp"
+#include "columns.hpp"
 #include "accounts.hpp"
 #include "incomes.hpp"
 
@@ -26,39 +27,11 @@ using namespace budget;
 namespace {
 
 budget::money monthly_income(budget::month month, budget::year year) {
-    std::map<size_t, budget::money> account_sum;
-
-    for (auto& earning : all_earnings()) {
-        if (earning.date.year() == year && earning.date.month() == month) {
-            account_sum[earning.account] += earning.amount;
-        }
-    }
-
-    budget::money total = get_base_income();
-
-    for (auto& sum : account_sum) {
-        total += sum.second;
-    }
-
-    return total;
+    return get_base_income() + sum_amounts(*earnings_columns(), column_month(year, month), column_month(year, month));
 }
 
 budget::money monthly_spending(budget::month month, budget::year year) {
-    std::map<size_t, budget::money> account_sum;
-
-    for (auto& expense : all_expenses()) {
-        if (expense.date.year() == year && expense.date.month() == month) {
-            account_sum[expense.account] += expense.amount;
-        }
-    }
-
-    budget::money total;
-
-    for (auto& sum : account_sum) {
-        total += sum.second;
-    }
-
-    return total;
+    return sum_amounts(*expenses_columns(), column_month(year, month), column_month(year, month));
 }
 
 void cash_flow_card(budget::html_writer& w){
@@ -102,46 +75,51 @@ void cash_flow_card(budget::html_writer& w){
 } // namespace
 
 void budget::index_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
-    if (!page_start(req, res, content_stream, "")) {
-        return;
-    }
+    // The cards are computed concurrently and each one is sent as soon as it is ready
+    stream_page(req, res, "", [](budget::html_writer& w) {
+        bool left_column = !all_assets().empty() && !all_asset_values().empty();
 
-    budget::html_writer w(content_stream);
+        std::vector<std::function<void(budget::html_writer&)>> cards;
 
-    bool left_column = !all_assets().empty() && !all_asset_values().empty();
+        if (left_column) {
+            cards.emplace_back([](budget::html_writer& w) {
+                // A. The left column
 
-    if (left_column) {
-        // A. The left column
+                w << R"=====(<div class="row">)=====";
 
-        w << R"=====(<div class="row">)=====";
+                w << R"=====(<div class="col-lg-4 d-none d-lg-block">)====="; // left column
 
-        w << R"=====(<div class="col-lg-4 d-none d-lg-block">)====="; // left column
+                assets_card(w);
 
-        assets_card(w);
+                w << R"=====(</div>)====="; // left column
 
-        w << R"=====(</div>)====="; // left column
+                // B. The right column
 
-        // B. The right column
-
-        w << R"=====(<div class="col-lg-8 col-md-12">)====="; // right column
-    }
+                w << R"=====(<div class="col-lg-8 col-md-12">)====="; // right column
+            });
+        }
 
-    // 1. Display the net worth graph
-    net_worth_graph(w, "min-width: 300px; width: 100%; height: 300px;", true);
+        // 1. Display the net worth graph
+        cards.emplace_back([](budget::html_writer& w) {
+            net_worth_graph(w, "min-width: 300px; width: 100%; height: 300px;", true);
+        });
 
-    // 2. Cash flow
-    cash_flow_card(w);
+        // 2. Cash flow
+        cards.emplace_back([](budget::html_writer& w) {
+            cash_flow_card(w);
+        });
 
-    // 3. Display the objectives status
-    objectives_card(w);
+        // 3. Display the objectives status
+        cards.emplace_back([left_column](budget::html_writer& w) {
+            objectives_card(w);
 
-    if (left_column) {
-        w << R"=====(</div>)====="; // right column
+            if (left_column) {
+                w << R"=====(</div>)====="; // right column
 
-        w << R"=====(</div>)====="; // row
-    }
+                w << R"=====(</div>)====="; // row
+            }
+        });
 
-    // end the page
-    page_end(w, req, res);
+        render_cards(w, cards);
+    });
 }
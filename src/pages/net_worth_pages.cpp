@@ -162,30 +162,11 @@ void budget::net_worth_graph(budget::html_writer& w, const std::string style, bo
     }
 
     ss << "series: [";
-
-    ss << "{ name: 'Net Worth',";
-    ss << "data: [";
-
-    auto date     = budget::asset_start_date();
-    auto end_date = budget::local_day();
-
-    while (date <= end_date) {
-        budget::money sum;
-
-        for (auto & asset : all_user_assets()) {
-            sum += get_asset_value(asset, date);
-        }
-
-        ss << "[Date.UTC(" << date.year() << "," << date.month().value - 1 << "," << date.day() << ") ," << budget::to_flat_string(sum) << "],";
-
-        date += days(1);
-    }
-
-    ss << "]},";
-
+    ss << "{ name: 'Net Worth', data: [] },";
     ss << "]";
 
-    end_chart(w, ss);
+    // The points are loaded and downsampled by the series API
+    end_async_chart(w, ss, {"/api/series/net_worth/"});
 
     if (card) {
         w << R"=====(</div>)====="; //card-body
@@ -194,19 +175,13 @@ void budget::net_worth_graph(budget::html_writer& w, const std::string style, bo
 }
 
 void budget::net_worth_status_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
-    if (!page_start(req, res, content_stream, "Net Worth Status")) {
-        return;
-    }
-
-    budget::html_writer w(content_stream);
-    budget::show_asset_values(w);
-
-    page_end(w, req, res);
+    stream_page(req, res, "Net Worth Status", [](budget::html_writer& w) {
+        budget::show_asset_values(w);
+    });
 }
 
 void budget::net_worth_small_status_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Net Worth Status")) {
         return;
     }
@@ -218,20 +193,13 @@ void budget::net_worth_small_status_page(const httplib::Request& req, httplib::R
 }
 
 void budget::net_worth_graph_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
-    if (!page_start(req, res, content_stream, "Net Worth Graph")) {
-        return;
-    }
-
-    budget::html_writer w(content_stream);
-
-    net_worth_graph(w);
-
-    page_end(w, req, res);
+    stream_page(req, res, "Net Worth Graph", [](budget::html_writer& w) {
+        net_worth_graph(w);
+    });
 }
 
 void budget::net_worth_allocation_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Net Worth Allocation")) {
         return;
     }
@@ -346,7 +314,7 @@ void budget::net_worth_allocation_page(const httplib::Request& req, httplib::Res
 }
 
 void budget::portfolio_allocation_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Portfolio Allocation")) {
         return;
     }
@@ -485,7 +453,7 @@ void budget::portfolio_allocation_page(const httplib::Request& req, httplib::Res
 }
 
 void budget::net_worth_currency_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Net Worth Graph")) {
         return;
     }
@@ -592,7 +560,7 @@ void budget::net_worth_currency_page(const httplib::Request& req, httplib::Respo
 }
 
 void budget::portfolio_status_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Portfolio")) {
         return;
     }
@@ -606,7 +574,7 @@ void budget::portfolio_status_page(const httplib::Request& req, httplib::Respons
 }
 
 void budget::portfolio_currency_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Portfolio Graph")) {
         return;
     }
@@ -719,7 +687,7 @@ void budget::portfolio_currency_page(const httplib::Request& req, httplib::Respo
 }
 
 void budget::portfolio_graph_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Portfolio Graph")) {
         return;
     }
@@ -780,7 +748,7 @@ void budget::portfolio_graph_page(const httplib::Request& req, httplib::Response
 }
 
 void budget::rebalance_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Rebalance")) {
         return;
     }
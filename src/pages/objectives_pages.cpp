@@ -194,7 +194,7 @@ void budget::objectives_card(budget::html_writer& w){
 }
 
 void budget::list_objectives_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Objectives List")) {
         return;
     }
@@ -208,7 +208,7 @@ void budget::list_objectives_page(const httplib::Request& req, httplib::Response
 }
 
 void budget::status_objectives_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Objectives Status")) {
         return;
     }
@@ -220,7 +220,7 @@ void budget::status_objectives_page(const httplib::Request& req, httplib::Respon
 }
 
 void budget::add_objectives_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "New objective")) {
         return;
     }
@@ -243,7 +243,7 @@ void budget::add_objectives_page(const httplib::Request& req, httplib::Response&
 }
 
 void budget::edit_objectives_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
 
     if (!page_get_start(req, res, content_stream, "Edit Objective", {"input_id", "back_page"})){
         return;
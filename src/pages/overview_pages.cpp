@@ -15,11 +15,12 @@
 #include "http.hpp"
 #include "config.hpp"
 #include "compute.hpp"
+#include "monthly_series.hpp"
 
 using namespace budget;
 
 void budget::overview_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Overview")) {
         return;
     }
@@ -36,7 +37,7 @@ void budget::overview_page(const httplib::Request& req, httplib::Response& res)
 }
 
 void budget::overview_aggregate_all_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Overview Aggregate")) {
         return;
     }
@@ -54,7 +55,7 @@ void budget::overview_aggregate_all_page(const httplib::Request& req, httplib::R
 }
 
 void budget::overview_aggregate_year_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Overview Aggregate")) {
         return;
     }
@@ -77,7 +78,7 @@ void budget::overview_aggregate_year_page(const httplib::Request& req, httplib::
 }
 
 void budget::overview_aggregate_month_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Overview Aggregate")) {
         return;
     }
@@ -100,7 +101,7 @@ void budget::overview_aggregate_month_page(const httplib::Request& req, httplib:
 }
 
 void budget::overview_year_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Overview Year")) {
         return;
     }
@@ -117,7 +118,7 @@ void budget::overview_year_page(const httplib::Request& req, httplib::Response&
 }
 
 void budget::time_graph_savings_rate_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Savings rate over time")) {
         return;
     }
@@ -135,40 +136,18 @@ void budget::time_graph_savings_rate_page(const httplib::Request& req, httplib::
     ss << "{ name: 'Savings Rate',";
     ss << "data: [";
 
-    std::vector<float> serie;
-    std::vector<std::string> dates;
+    auto status = monthly_status(history_start(), budget::local_day());
 
-    auto sy = start_year();
+    budget::monthly_series<float> serie(history_start(), budget::local_day());
 
-    for (unsigned short j = sy; j <= budget::local_day().year(); ++j) {
-        budget::year year = j;
+    for (size_t i = 0; i < status.size(); ++i) {
+        auto savings = status[i].income - status[i].expenses;
 
-        auto sm = start_month(year);
-        auto last = 13;
-
-        if (year == budget::local_day().year()) {
-            last = budget::local_day().month() + 1;
+        if (savings.dollars() > 0) {
+            serie[i] = savings / status[i].income;
         }
 
-        for (unsigned short i = sm; i < last; ++i) {
-            budget::month month = i;
-
-            auto status = budget::compute_month_status(year, month);
-
-            auto savings = status.income - status.expenses;
-            auto savings_rate = 0.0;
-
-            if (savings.dollars() > 0) {
-                savings_rate = savings / status.income;
-            }
-
-            std::string date = "Date.UTC(" + std::to_string(year) + "," + std::to_string(month.value - 1) + ", 1)";
-
-            serie.push_back(savings_rate);
-            dates.push_back(date);
-
-            ss << "[" << date << " ," << 100.0 * savings_rate << "],";
-        }
+        ss << "[" << chart_date(serie.month_date(i)) << " ," << 100.0 * serie[i] << "],";
     }
 
     ss << "]},";
@@ -176,21 +155,10 @@ void budget::time_graph_savings_rate_page(const httplib::Request& req, httplib::
     ss << "{ name: '12 months average',";
     ss << "data: [";
 
-    std::array<float, 12> average_12;
-    average_12.fill(0.0f);
-
-    for (size_t i = 0; i < serie.size(); ++i) {
-        average_12[i % 12] = serie[i];
-
-        auto average = std::accumulate(average_12.begin(), average_12.end(), 0.0f);
-
-        if (i < 12) {
-            average = average / float(i + 1);
-        } else {
-            average = average / 12.f;
-        }
+    auto average = rolling_average(serie, 12);
 
-        ss << "[" << dates[i] << "," << 100.0 * average << "],";
+    for (size_t i = 0; i < average.size(); ++i) {
+        ss << "[" << chart_date(average.month_date(i)) << "," << 100.0 * average[i] << "],";
     }
 
     ss << "]},";
@@ -0,0 +1,391 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <chrono>
+#include <ctime>
+#include <algorithm>
+#include <unordered_map>
+
+#include "compression.hpp"
+#include "config.hpp"
+#include "budget_exception.hpp"
+#include "data.hpp"
+#include "date.hpp"
+#include "http.hpp"
+#include "scheduler.hpp"
+
+#include "pages/page_cache.hpp"
+#include "pages/server_pages.hpp"
+
+namespace {
+
+struct page_entry {
+    std::string signature; ///< The day and generations the page was rendered with
+    std::string content_type;
+    std::string body;
+    std::string gzip_body;    ///< Compressed on the first request accepting gzip
+    std::string deflate_body; ///< Compressed on the first request accepting deflate
+};
+
+// Bounds the memory used by pages with many different parameters
+constexpr const size_t max_cached_pages = 256;
+
+std::mutex cache_lock;
+std::unordered_map<std::string, page_entry> cache;
+
+// The capture of the page being rendered by this thread, set during its handler
+thread_local budget::page_capture current_capture;
+
+// Indicates that this thread is rendering a page only to cache it
+thread_local bool prerendering = false;
+
+// The time the data of the hot pages must be stable before they are pre-rendered
+constexpr const std::chrono::seconds prerender_delay(2);
+
+struct hot_page_entry {
+    std::string path;
+    budget::page_handler handler; ///< The cached handler of the page
+    std::vector<std::atomic<size_t>*> generations;
+    std::string rendered; ///< The signature of the last pre-rendering
+};
+
+// Protects the hot pages and prevents concurrent pre-renderings
+std::mutex hot_pages_lock;
+std::vector<hot_page_entry> hot_pages;
+
+// Identifies the page, by its path and its parameters
+std::string page_slot(const httplib::Request& req){
+    std::string slot = req.path;
+
+    for (auto& param : req.params) {
+        slot += '&';
+        slot += param.first;
+        slot += '=';
+        slot += param.second;
+    }
+
+    return slot;
+}
+
+std::vector<std::atomic<size_t>*> page_generations(const std::vector<std::string>& modules){
+    // Every page depends on the configuration
+    std::vector<std::atomic<size_t>*> generations{&budget::module_generation("config")};
+
+    for (auto& module : modules) {
+        generations.push_back(&budget::module_generation(module));
+    }
+
+    return generations;
+}
+
+std::string page_signature(const std::vector<std::atomic<size_t>*>& generations){
+    std::string signature = budget::date_to_string(budget::local_day());
+
+    for (auto* generation : generations) {
+        signature += ':';
+        signature += std::to_string(generation->load());
+    }
+
+    return signature;
+}
+
+// The ETag depends on the encoding since the bytes are different
+std::string page_etag(const std::string& slot, const std::string& signature, const std::string& encoding){
+    std::stringstream ss;
+    ss << '"' << std::hex << std::hash<std::string>()(slot) << '-' << std::hash<std::string>()(signature);
+
+    if (!encoding.empty()) {
+        ss << '-' << encoding;
+    }
+
+    ss << '"';
+    return ss.str();
+}
+
+std::string& encoded_body(page_entry& entry, const std::string& encoding){
+    if (encoding == "gzip") {
+        return entry.gzip_body;
+    } else {
+        return entry.deflate_body;
+    }
+}
+
+void send_page(httplib::Response& res, const std::string& body, const std::string& content_type, const std::string& encoding){
+    if (!encoding.empty()) {
+        res.set_header("Content-Encoding", encoding.c_str());
+    }
+
+    res.set_content(body, content_type.c_str());
+}
+
+void store_page(const std::string& slot, page_entry&& entry){
+    // Small pages may still hold the whole first chunk of the writer
+    if (entry.body.capacity() > 2 * entry.body.size()) {
+        entry.body.shrink_to_fit();
+    }
+
+    std::lock_guard<std::mutex> lock(cache_lock);
+
+    if (cache.size() >= max_cached_pages && !cache.count(slot)) {
+        cache.clear();
+    }
+
+    cache[slot] = std::move(entry);
+}
+
+bool is_hot(const hot_page_entry& page, const std::vector<std::string>& configured){
+    return std::find(configured.begin(), configured.end(), page.path) != configured.end();
+}
+
+// Render the page as a request without parameters, into the cache
+void prerender(hot_page_entry& page, const std::string& signature){
+    httplib::Request req;
+    req.method = "GET";
+    req.path   = page.path;
+
+    httplib::Response res;
+
+    prerendering = true;
+
+    try {
+        page.handler(req, res);
+    } catch (const budget::budget_exception& e) {
+        std::cout << "ERROR: Failed to pre-render " << page.path << ": " << e.message() << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "ERROR: Failed to pre-render " << page.path << ": " << e.what() << std::endl;
+    }
+
+    prerendering = false;
+
+    page.rendered = signature;
+}
+
+} // end of anonymous namespace
+
+budget::page_handler budget::cached_page(page_handler handler, const std::vector<std::string>& modules){
+    auto generations = page_generations(modules);
+
+    return [handler, generations](const httplib::Request& req, httplib::Response& res) {
+        // Cached pages must not be served without authentication
+        if (!authenticate(req, res)) {
+            return;
+        }
+
+        auto slot      = page_slot(req);
+        auto signature = page_signature(generations);
+        auto encoding  = budget::negotiate_encoding(req.get_header_value("Accept-Encoding"));
+        auto etag      = page_etag(slot, signature, encoding);
+
+        // The browser must always revalidate the page
+        res.set_header("Cache-Control", "no-cache");
+        res.set_header("Vary", "Accept-Encoding");
+
+        if (req.has_header("If-None-Match") && req.get_header_value("If-None-Match") == etag) {
+            res.status = 304;
+            res.set_header("ETag", etag.c_str());
+            return;
+        }
+
+        // The body of a cached page that has not been compressed yet for this encoding
+        bool hit = false;
+        std::string body;
+        std::string content_type;
+
+        {
+            std::lock_guard<std::mutex> lock(cache_lock);
+
+            auto it = cache.find(slot);
+            if (it != cache.end() && it->second.signature == signature) {
+                auto& entry = it->second;
+
+                if (encoding.empty() || entry.body.size() < budget::compression_threshold) {
+                    res.set_header("ETag", etag.c_str());
+                    send_page(res, entry.body, entry.content_type, "");
+                    return;
+                }
+
+                if (!encoded_body(entry, encoding).empty()) {
+                    res.set_header("ETag", etag.c_str());
+                    send_page(res, encoded_body(entry, encoding), entry.content_type, encoding);
+                    return;
+                }
+
+                hit          = true;
+                body         = entry.body;
+                content_type = entry.content_type;
+            }
+        }
+
+        // The other requests must not wait for the compression of the page
+        if (hit) {
+            auto encoded = budget::compress(body, encoding);
+
+            // A page that cannot be compressed is sent as is, without tag
+            if (encoded.empty()) {
+                send_page(res, body, content_type, "");
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(cache_lock);
+
+                // The page may have been rendered again in the meantime
+                auto it = cache.find(slot);
+                if (it != cache.end() && it->second.signature == signature && encoded_body(it->second, encoding).empty()) {
+                    encoded_body(it->second, encoding) = encoded;
+                }
+            }
+
+            res.set_header("ETag", etag.c_str());
+            send_page(res, encoded, content_type, encoding);
+            return;
+        }
+
+        current_capture = [slot, signature, generations](std::string&& body, const std::string& content_type) {
+            if (page_signature(generations) == signature) {
+                page_entry entry;
+                entry.signature    = signature;
+                entry.content_type = content_type;
+                entry.body         = std::move(body);
+
+                store_page(slot, std::move(entry));
+            }
+        };
+
+        handler(req, res);
+
+        // A streamed page took the capture, it is cached once it has been sent
+        bool streamed = !current_capture;
+        current_capture = nullptr;
+
+        if (streamed || (res.status != -1 && res.status != 200)) {
+            return;
+        }
+
+        bool cacheable = page_signature(generations) == signature;
+
+        page_entry entry;
+        entry.signature    = signature;
+        entry.content_type = res.get_header_value("Content-Type");
+
+        bool compressible = !encoding.empty() && res.body.size() >= budget::compression_threshold;
+
+        // The response already has its content type, only its body is replaced
+        if (!compressible) {
+            if (cacheable) {
+                entry.body = res.body;
+            }
+        } else {
+            auto compressed = budget::compress(res.body, encoding);
+
+            // A page that cannot be compressed is neither cached nor tagged
+            if (compressed.empty()) {
+                return;
+            }
+
+            entry.body                    = std::move(res.body);
+            encoded_body(entry, encoding) = std::move(compressed);
+
+            res.set_header("Content-Encoding", encoding.c_str());
+            res.body = encoded_body(entry, encoding);
+        }
+
+        // The page is only cached if nothing changed during the rendering
+        if (cacheable) {
+            res.set_header("ETag", etag.c_str());
+
+            store_page(slot, std::move(entry));
+        }
+    };
+}
+
+budget::page_capture budget::take_page_capture(){
+    auto capture = std::move(current_capture);
+    current_capture = nullptr;
+    return capture;
+}
+
+budget::page_handler budget::hot_page(const std::string& path, page_handler handler, const std::vector<std::string>& modules){
+    auto cached = cached_page(handler, modules);
+
+    hot_page_entry page;
+    page.path        = path;
+    page.handler     = cached;
+    page.generations = page_generations(modules);
+
+    std::lock_guard<std::mutex> lock(hot_pages_lock);
+    hot_pages.push_back(std::move(page));
+
+    return cached;
+}
+
+void budget::prerender_hot_pages(){
+    auto configured = get_server_hot_pages();
+
+    std::lock_guard<std::mutex> lock(hot_pages_lock);
+
+    for (auto& path : configured) {
+        auto it = std::find_if(hot_pages.begin(), hot_pages.end(), [&path](const hot_page_entry& page) { return page.path == path; });
+
+        if (it == hot_pages.end()) {
+            std::cout << "ERROR: The page " << path << " cannot be pre-rendered" << std::endl;
+            continue;
+        }
+
+        auto signature = page_signature(it->generations);
+
+        if (it->rendered != signature) {
+            std::cout << "INFO: Pre-rendering " << path << std::endl;
+
+            prerender(*it, signature);
+        }
+    }
+}
+
+void budget::refresh_hot_pages(){
+    auto configured = get_server_hot_pages();
+
+    std::lock_guard<std::mutex> lock(hot_pages_lock);
+
+    for (auto& page : hot_pages) {
+        if (!is_hot(page, configured)) {
+            continue;
+        }
+
+        auto signature = page_signature(page.generations);
+
+        if (page.rendered != signature) {
+            prerender(page, signature);
+        }
+    }
+}
+
+void budget::schedule_hot_pages_refresh(){
+    // Several writes often come together, the pages are rendered once they are done
+    budget::schedule_once("hot_pages", prerender_delay, &budget::refresh_hot_pages);
+}
+
+void budget::schedule_hot_pages_rollover(){
+    auto tt      = time(NULL);
+    auto timeval = localtime(&tt);
+
+    // The day is part of the signature, the pages are refreshed just after midnight
+    auto elapsed = timeval->tm_hour * 3600 + timeval->tm_min * 60 + timeval->tm_sec;
+    std::chrono::seconds delay(24 * 3600 - elapsed + 1);
+
+    budget::schedule_once("hot_pages_rollover", delay, []() {
+        budget::refresh_hot_pages();
+        budget::schedule_hot_pages_rollover();
+    });
+}
+
+bool budget::is_prerendering(){
+    return prerendering;
+}
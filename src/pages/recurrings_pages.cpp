@@ -16,7 +16,7 @@
 using namespace budget;
 
 void budget::recurrings_list_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Recurrings List")) {
         return;
     }
@@ -30,7 +30,7 @@ void budget::recurrings_list_page(const httplib::Request& req, httplib::Response
 }
 
 void budget::add_recurrings_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "New Recurring Expense")) {
         return;
     }
@@ -51,7 +51,7 @@ void budget::add_recurrings_page(const httplib::Request& req, httplib::Response&
 }
 
 void budget::edit_recurrings_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Edit Recurring Expense")) {
         return;
     }
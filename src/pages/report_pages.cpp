@@ -15,7 +15,7 @@
 using namespace budget;
 
 void budget::report_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Report")) {
         return;
     }
@@ -34,34 +34,20 @@ void add_percent_picker(budget::writer& w, const std::string& title, const std::
 } // namespace
 
 void budget::retirement_status_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
-    if (!page_start(req, res, content_stream, "Retirement status")) {
-        return;
-    }
-
-    budget::html_writer w(content_stream);
-
-    w << title_begin << "Retirement status" << title_end;
-
-    if(!internal_config_contains("withdrawal_rate")){
-        display_error_message(w, "Not enough information, please configure Retirement Options first");
-        page_end(w, req, res);
-        return;
-    }
-
-    if(!internal_config_contains("expected_roi")){
-        display_error_message(w, "Not enough information, please configure Retirement Options first");
-        page_end(w, req, res);
-        return;
-    }
+    stream_page(req, res, "Retirement status", [](budget::html_writer& w) {
+        w << title_begin << "Retirement status" << title_end;
 
-    budget::retirement_status(w);
+        if (!internal_config_contains("withdrawal_rate") || !internal_config_contains("expected_roi")) {
+            display_error_message(w, "Not enough information, please configure Retirement Options first");
+            return;
+        }
 
-    page_end(w, req, res);
+        budget::retirement_status(w);
+    });
 }
 
 void budget::retirement_configure_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Retirement configure")) {
         return;
     }
@@ -90,48 +76,27 @@ void budget::retirement_configure_page(const httplib::Request& req, httplib::Res
 }
 
 void budget::retirement_fi_ratio_over_time(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
-    if (!page_start(req, res, content_stream, "FI Ratio over time")) {
-        return;
-    }
+    stream_page(req, res, "FI Ratio over time", [](budget::html_writer& w) {
+        if (all_assets().empty() || all_asset_values().empty()) {
+            return;
+        }
 
-    budget::html_writer w(content_stream);
-
-    if (all_assets().empty() || all_asset_values().empty()){
-        page_end(w, req, res);
-        return;
-    }
-
-    auto ss = start_time_chart(w, "FI Ratio over time", "line", "fi_time_graph", "");
-
-    ss << R"=====(xAxis: { type: 'datetime', title: { text: 'Date' }},)=====";
-    ss << R"=====(yAxis: { min: 0, title: { text: 'FI Ratio' }},)=====";
-    ss << R"=====(legend: { enabled: false },)=====";
-
-    ss << "series: [";
+        if (!internal_config_contains("withdrawal_rate")) {
+            display_error_message(w, "Not enough information, please configure Retirement Options first");
+            return;
+        }
 
-    ss << "{ name: 'FI Ratio %',";
-    ss << "data: [";
+        auto ss = start_time_chart(w, "FI Ratio over time", "line", "fi_time_graph", "");
 
-    std::vector<budget::money> serie;
-    std::vector<std::string> dates;
+        ss << R"=====(xAxis: { type: 'datetime', title: { text: 'Date' }},)=====";
+        ss << R"=====(yAxis: { min: 0, title: { text: 'FI Ratio' }},)=====";
+        ss << R"=====(legend: { enabled: false },)=====";
 
-    auto date     = budget::asset_start_date();
-    auto end_date = budget::local_day();
+        ss << "series: [";
+        ss << "{ name: 'FI Ratio %', data: [] },";
+        ss << "]";
 
-    while (date <= end_date) {
-        auto ratio = budget::fi_ratio(date);
-
-        std::string datestr = "Date.UTC(" + std::to_string(date.year()) + "," + std::to_string(date.month().value - 1) + ", 1)";
-        ss << "[" << datestr << "," << budget::to_string(100 * ratio) << "],";
-
-        date += days(1);
-    }
-
-    ss << "]},";
-    ss << "]";
-
-    end_chart(w, ss);
-
-    page_end(w, req, res);
+        // The points are loaded and downsampled by the series API
+        end_async_chart(w, ss, {"/api/series/fi_ratio/"});
+    });
 }
@@ -7,6 +7,7 @@
 
 #include <set>
 #include <numeric>
+#include <memory>
 
 #include "cpp_utils/assert.hpp"
 
@@ -21,6 +22,11 @@
 #include "version.hpp"
 #include "writer.hpp"
 #include "currency.hpp"
+#include "static_assets.hpp"
+#include "search_index.hpp"
+#include "task_pool.hpp"
+
+#include "pages/page_cache.hpp"
 
 // Include all the pages
 #include "pages/assets_pages.hpp"
@@ -48,7 +54,8 @@ namespace {
 
 static constexpr const char new_line = '\n';
 
-std::string header(const std::string& title, bool menu = true) {
+// The static part of the page, before the title
+std::string shell_head() {
     std::stringstream stream;
 
     // The header
@@ -64,116 +71,17 @@ std::string header(const std::string& title, bool menu = true) {
             <meta name="author" content="Baptiste Wicht">
 
             <!-- The CSS -->
-
-            <link rel="stylesheet" href="https://cdnjs.cloudflare.com/ajax/libs/twitter-bootstrap/4.0.0-beta.3/css/bootstrap.min.css" integrity="sha256-PCsx7lOyGhyGmzsO5MGXhzwV6UpNTlNf1p6V6w2CppQ=" crossorigin="anonymous" />
-
-            <style>
-                body {
-                  padding-top: 5rem;
-                }
-
-                p {
-                    margin-bottom: 8px;
-                }
-
-                .asset_group {
-                    margin-left: -20px;
-                    margin-right: -20px;
-                    padding-left: 5px;
-                    border-bottom: 1px solid #343a40;
-                    font-weight: bold;
-                    color: #343a40;
-                }
-
-                .asset_row {
-                    padding-top: 3px;
-                }
-
-                .asset_row:not(:last-child) {
-                    border-bottom: 1px solid rgba(0,0,0,0.125);
-                }
-
-                .asset_name {
-                    font-weight: bold;
-                    color: #007bff;
-                    padding-left: 5px;
-                }
-
-                .asset_right {
-                    padding-left: 0px;
-                    padding-right: 5px;
-                }
-
-                .asset_date {
-                    color: rgba(0,0,0,0.5);
-                }
-
-                .small-form-inline {
-                    float: left;
-                    padding-right: 10px;
-                }
-
-                .small-text {
-                    font-size: 10pt;
-                }
-
-                .extend-only {
-                    width: 75%;
-                }
-
-                .selector a {
-                    font-size: xx-large;
-                }
-
-                .selector select {
-                    vertical-align: middle;
-                    margin-bottom: 22px;
-                    margin-left: 2px;
-                    margin-right: 2px;
-                }
-
-                .card {
-                    margin-bottom: 10px !important;
-                }
-
-                .card-header-primary {
-                    color:white !important;
-                    background-color: #007bff !important;
-                    padding: 0.5rem 0.75rem !important;
-                }
-
-                .gauge-cash-flow-title {
-                    margin-top: -15px;
-                }
-
-                .gauge-objective-title {
-                    color: rgb(124, 181, 236);
-                    margin-top: -15px;
-                    text-align: center;
-                }
-
-                .default-graph-style {
-                    min-width: 300px;
-                    height: 400px;
-                    margin: 0 auto;
-                }
-
-                .dataTables_wrapper {
-                    padding-left: 0px !important;
-                    padding-right: 0px !important;
-                }
-
-                .flat-hr {
-                    margin:0px;
-                }
-            </style>
     )=====";
 
-    if (title.empty()) {
-        stream << "<title>budgetwarrior</title>";
-    } else {
-        stream << "<title>budgetwarrior - " << title << "</title>";
-    }
+    write_asset_tag(stream, "twitter-bootstrap/4.0.0-beta.3/css/bootstrap.min.css");
+    write_asset_tag(stream, "budget.css");
+
+    return stream.str();
+}
+
+// The static part of the page, after the title
+std::string shell_body(bool menu) {
+    std::stringstream stream;
 
     stream << new_line;
 
@@ -267,6 +175,7 @@ std::string header(const std::string& title, bool menu = true) {
                 <div class="dropdown-menu" aria-labelledby="dropdown04">
                   <a class="dropdown-item" href="/earnings/add/">Add Earning</a>
                   <a class="dropdown-item" href="/earnings/">Earnings</a>
+                  <a class="dropdown-item" href="/earnings/search/">Search</a>
                   <a class="dropdown-item" href="/earnings/all/">All Earnings</a>
                   <a class="dropdown-item" href="/earnings/time/">Earnings over time</a>
                   <a class="dropdown-item" href="/income/time/">Income over time</a>
@@ -381,6 +290,33 @@ std::string header(const std::string& title, bool menu = true) {
     return stream.str();
 }
 
+// The fragments of the page that do not depend on the request
+struct page_shell {
+    std::string head;
+    std::string body_menu;
+    std::string body_no_menu;
+};
+
+const page_shell& shell() {
+    // Built on the first call, done in load_pages before the server starts
+    static const page_shell shell{shell_head(), shell_body(true), shell_body(false)};
+    return shell;
+}
+
+void write_header(std::ostream& stream, const std::string& title, bool menu = true) {
+    auto& fragments = shell();
+
+    stream << fragments.head;
+
+    if (title.empty()) {
+        stream << "<title>budgetwarrior</title>";
+    } else {
+        stream << "<title>budgetwarrior - " << title << "</title>";
+    }
+
+    stream << (menu ? fragments.body_menu : fragments.body_no_menu);
+}
+
 void display_message(budget::writer& w, const httplib::Request& req) {
     if (req.has_param("message")) {
         if (req.has_param("error")) {
@@ -396,20 +332,6 @@ void display_message(budget::writer& w, const httplib::Request& req) {
     }
 }
 
-void replace_all(std::string& source, const std::string& from, const std::string& to) {
-    size_t current_pos = 0;
-
-    while ((current_pos = source.find(from, current_pos)) != std::string::npos) {
-        source.replace(current_pos, from.length(), to);
-        current_pos += to.length();
-    }
-}
-
-void filter_html(std::string& html, const httplib::Request& req) {
-    replace_all(html, "__budget_this_page__", req.path);
-    replace_all(html, "__currency__", get_default_currency());
-}
-
 //Note: This must be synchronized with page_end
 std::string footer() {
     return "</main></body></html>";
@@ -425,7 +347,25 @@ bool parameters_present(const httplib::Request& req, std::vector<const char*> pa
     return true;
 }
 
-bool validate_parameters(std::stringstream& content_stream, const httplib::Request& req, std::vector<const char*> parameters) {
+// Write the beginning of the page, up to its content
+void start_content(const httplib::Request& req, budget::chunked_stream& content_stream, const std::string& title) {
+    // The placeholders are resolved while the page is written
+    content_stream.buffer.add_placeholder("__budget_this_page__", req.path);
+    content_stream.buffer.add_placeholder("__currency__", get_default_currency());
+
+    write_header(content_stream, title);
+
+    budget::html_writer w(content_stream);
+    display_message(w, req);
+}
+
+void end_content(budget::html_writer& w) {
+    w << "</main>";
+    w.load_deferred_scripts();
+    w << "</body></html>";
+}
+
+bool validate_parameters(budget::chunked_stream& content_stream, const httplib::Request& req, std::vector<const char*> parameters) {
     if(!parameters_present(req, parameters)){
         budget::html_writer w(content_stream);
 
@@ -439,121 +379,147 @@ bool validate_parameters(std::stringstream& content_stream, const httplib::Reque
 
 } //end of anonymous namespace
 
-void budget::load_pages(httplib::Server& server) {
-    // Declare all the pages
-    server.Get("/", &index_page);
-
-    server.Get("/overview/year/", &overview_year_page);
-    server.Get(R"(/overview/year/(\d+)/)", &overview_year_page);
-    server.Get("/overview/", &overview_page);
-    server.Get(R"(/overview/(\d+)/(\d+)/)", &overview_page);
-    server.Get("/overview/aggregate/year/", &overview_aggregate_year_page);
-    server.Get(R"(/overview/aggregate/year/(\d+)/)", &overview_aggregate_year_page);
-    server.Get("/overview/aggregate/month/", &overview_aggregate_month_page);
-    server.Get(R"(/overview/aggregate/month/(\d+)/(\d+)/)", &overview_aggregate_month_page);
-    server.Get("/overview/aggregate/all/", &overview_aggregate_all_page);
-    server.Get("/overview/savings/time/", &time_graph_savings_rate_page);
-
-    server.Get("/report/", &report_page);
-
-    server.Get("/accounts/", &accounts_page);
-    server.Get("/accounts/all/", &all_accounts_page);
-    server.Get("/accounts/add/", &add_accounts_page);
+void budget::load_pages(budget::metered_server& server) {
+    // The modules each page depends on, for the page cache
+    const std::vector<std::string> none_modules;
+    const std::vector<std::string> accounts_modules{"accounts"};
+    const std::vector<std::string> incomes_modules{"incomes"};
+    const std::vector<std::string> expenses_modules{"expenses", "accounts"};
+    const std::vector<std::string> earnings_modules{"earnings", "accounts"};
+    const std::vector<std::string> income_modules{"incomes", "earnings"};
+    const std::vector<std::string> budget_modules{"accounts", "incomes", "expenses", "earnings"};
+    const std::vector<std::string> net_worth_modules{"assets", "asset_values", "asset_shares", "currency", "share_prices"};
+    const std::vector<std::string> objectives_modules{"objectives"};
+    const std::vector<std::string> wishes_modules{"wishes"};
+    const std::vector<std::string> recurrings_modules{"recurrings", "accounts"};
+    const std::vector<std::string> debts_modules{"debts"};
+    const std::vector<std::string> fortunes_modules{"fortunes"};
+    const std::vector<std::string> all_modules{"accounts", "incomes", "expenses", "earnings", "assets", "asset_values", "asset_shares",
+                                               "currency", "share_prices", "objectives", "wishes", "recurrings", "debts", "fortunes"};
+
+    // The static assets are referenced by the header of the pages
+    load_static_assets();
+
+    server.Get(R"(/static/([0-9a-f]+)/(.+))", &static_asset_page);
+
+    // Build the static parts of the pages once, before serving
+    shell();
+
+    // Declare all the pages, the hot pages can be pre-rendered in the background
+    server.Get("/", hot_page("/", &index_page, all_modules));
+
+    server.Get("/overview/year/", cached_page(&overview_year_page, budget_modules));
+    server.Get(R"(/overview/year/(\d+)/)", cached_page(&overview_year_page, budget_modules));
+    server.Get("/overview/", hot_page("/overview/", &overview_page, budget_modules));
+    server.Get(R"(/overview/(\d+)/(\d+)/)", cached_page(&overview_page, budget_modules));
+    server.Get("/overview/aggregate/year/", cached_page(&overview_aggregate_year_page, budget_modules));
+    server.Get(R"(/overview/aggregate/year/(\d+)/)", cached_page(&overview_aggregate_year_page, budget_modules));
+    server.Get("/overview/aggregate/month/", cached_page(&overview_aggregate_month_page, budget_modules));
+    server.Get(R"(/overview/aggregate/month/(\d+)/(\d+)/)", cached_page(&overview_aggregate_month_page, budget_modules));
+    server.Get("/overview/aggregate/all/", cached_page(&overview_aggregate_all_page, budget_modules));
+    server.Get("/overview/savings/time/", cached_page(&time_graph_savings_rate_page, budget_modules));
+
+    server.Get("/report/", hot_page("/report/", &report_page, budget_modules));
+
+    server.Get("/accounts/", cached_page(&accounts_page, accounts_modules));
+    server.Get("/accounts/all/", cached_page(&all_accounts_page, accounts_modules));
+    server.Get("/accounts/add/", cached_page(&add_accounts_page, none_modules));
     server.Post("/accounts/edit/", &edit_accounts_page);
-    server.Get("/accounts/archive/month/", &archive_accounts_month_page);
-    server.Get("/accounts/archive/year/", &archive_accounts_year_page);
+    server.Get("/accounts/archive/month/", cached_page(&archive_accounts_month_page, accounts_modules));
+    server.Get("/accounts/archive/year/", cached_page(&archive_accounts_year_page, accounts_modules));
 
-    server.Get("/incomes/", &incomes_page);
-    server.Get("/incomes/set/", &set_incomes_page);
+    server.Get("/incomes/", cached_page(&incomes_page, incomes_modules));
+    server.Get("/incomes/set/", cached_page(&set_incomes_page, incomes_modules));
 
-    server.Get(R"(/expenses/(\d+)/(\d+)/)", &expenses_page);
-    server.Get("/expenses/", &expenses_page);
-    server.Get("/expenses/search/", &search_expenses_page);
+    server.Get(R"(/expenses/(\d+)/(\d+)/)", cached_page(&expenses_page, expenses_modules));
+    server.Get("/expenses/", hot_page("/expenses/", &expenses_page, expenses_modules));
+    server.Get("/expenses/search/", cached_page(&search_expenses_page, expenses_modules));
 
-    server.Get(R"(/expenses/breakdown/month/(\d+)/(\d+)/)", &month_breakdown_expenses_page);
-    server.Get("/expenses/breakdown/month/", &month_breakdown_expenses_page);
+    server.Get(R"(/expenses/breakdown/month/(\d+)/(\d+)/)", cached_page(&month_breakdown_expenses_page, expenses_modules));
+    server.Get("/expenses/breakdown/month/", cached_page(&month_breakdown_expenses_page, expenses_modules));
 
-    server.Get(R"(/expenses/breakdown/year/(\d+)/)", &year_breakdown_expenses_page);
-    server.Get("/expenses/breakdown/year/", &year_breakdown_expenses_page);
+    server.Get(R"(/expenses/breakdown/year/(\d+)/)", cached_page(&year_breakdown_expenses_page, expenses_modules));
+    server.Get("/expenses/breakdown/year/", cached_page(&year_breakdown_expenses_page, expenses_modules));
 
-    server.Get("/expenses/time/", &time_graph_expenses_page);
-    server.Get("/expenses/all/", &all_expenses_page);
-    server.Get("/expenses/add/", &add_expenses_page);
+    server.Get("/expenses/time/", cached_page(&time_graph_expenses_page, expenses_modules));
+    server.Get("/expenses/all/", cached_page(&all_expenses_page, expenses_modules));
+    server.Get("/expenses/add/", cached_page(&add_expenses_page, accounts_modules));
     server.Post("/expenses/edit/", &edit_expenses_page);
 
-    server.Get(R"(/earnings/(\d+)/(\d+)/)", &earnings_page);
-    server.Get("/earnings/", &earnings_page);
+    server.Get(R"(/earnings/(\d+)/(\d+)/)", cached_page(&earnings_page, earnings_modules));
+    server.Get("/earnings/", hot_page("/earnings/", &earnings_page, earnings_modules));
+    server.Get("/earnings/search/", cached_page(&search_earnings_page, earnings_modules));
 
-    server.Get("/earnings/time/", &time_graph_earnings_page);
-    server.Get("/income/time/", &time_graph_income_page);
-    server.Get("/earnings/all/", &all_earnings_page);
-    server.Get("/earnings/add/", &add_earnings_page);
+    server.Get("/earnings/time/", cached_page(&time_graph_earnings_page, earnings_modules));
+    server.Get("/income/time/", cached_page(&time_graph_income_page, income_modules));
+    server.Get("/earnings/all/", cached_page(&all_earnings_page, earnings_modules));
+    server.Get("/earnings/add/", cached_page(&add_earnings_page, accounts_modules));
     server.Post("/earnings/edit/", &edit_earnings_page);
 
-    server.Get("/portfolio/status/", &portfolio_status_page);
-    server.Get("/portfolio/graph/", &portfolio_graph_page);
-    server.Get("/portfolio/currency/", &portfolio_currency_page);
-    server.Get("/portfolio/allocation/", &portfolio_allocation_page);
-    server.Get("/rebalance/", &rebalance_page);
-    server.Get("/assets/", &assets_page);
-    server.Get("/net_worth/status/", &net_worth_status_page);
-    server.Get("/net_worth/status/small/", &net_worth_small_status_page); // Not in the menu for now
-    server.Get("/net_worth/graph/", &net_worth_graph_page);
-    server.Get("/net_worth/currency/", &net_worth_currency_page);
-    server.Get("/net_worth/allocation/", &net_worth_allocation_page);
-    server.Get("/assets/add/", &add_assets_page);
+    server.Get("/portfolio/status/", hot_page("/portfolio/status/", &portfolio_status_page, net_worth_modules));
+    server.Get("/portfolio/graph/", cached_page(&portfolio_graph_page, net_worth_modules));
+    server.Get("/portfolio/currency/", cached_page(&portfolio_currency_page, net_worth_modules));
+    server.Get("/portfolio/allocation/", cached_page(&portfolio_allocation_page, net_worth_modules));
+    server.Get("/rebalance/", cached_page(&rebalance_page, net_worth_modules));
+    server.Get("/assets/", cached_page(&assets_page, net_worth_modules));
+    server.Get("/net_worth/status/", hot_page("/net_worth/status/", &net_worth_status_page, net_worth_modules));
+    server.Get("/net_worth/status/small/", cached_page(&net_worth_small_status_page, net_worth_modules)); // Not in the menu for now
+    server.Get("/net_worth/graph/", cached_page(&net_worth_graph_page, net_worth_modules));
+    server.Get("/net_worth/currency/", cached_page(&net_worth_currency_page, net_worth_modules));
+    server.Get("/net_worth/allocation/", cached_page(&net_worth_allocation_page, net_worth_modules));
+    server.Get("/assets/add/", cached_page(&add_assets_page, net_worth_modules));
     server.Post("/assets/edit/", &edit_assets_page);
 
-    server.Get("/asset_values/list/", &list_asset_values_page);
-    server.Get("/asset_values/add/", &add_asset_values_page);
-    server.Get("/asset_values/batch/full/", &full_batch_asset_values_page);
-    server.Get("/asset_values/batch/current/", &current_batch_asset_values_page);
+    server.Get("/asset_values/list/", cached_page(&list_asset_values_page, net_worth_modules));
+    server.Get("/asset_values/add/", cached_page(&add_asset_values_page, net_worth_modules));
+    server.Get("/asset_values/batch/full/", cached_page(&full_batch_asset_values_page, net_worth_modules));
+    server.Get("/asset_values/batch/current/", cached_page(&current_batch_asset_values_page, net_worth_modules));
     server.Post("/asset_values/edit/", &edit_asset_values_page);
 
-    server.Get("/asset_shares/list/", &list_asset_shares_page);
-    server.Get("/asset_shares/add/", &add_asset_shares_page);
+    server.Get("/asset_shares/list/", cached_page(&list_asset_shares_page, net_worth_modules));
+    server.Get("/asset_shares/add/", cached_page(&add_asset_shares_page, net_worth_modules));
     server.Post("/asset_shares/edit/", &edit_asset_shares_page);
 
-    server.Get("/objectives/list/", &list_objectives_page);
-    server.Get("/objectives/status/", &status_objectives_page);
-    server.Get("/objectives/add/", &add_objectives_page);
+    server.Get("/objectives/list/", cached_page(&list_objectives_page, objectives_modules));
+    server.Get("/objectives/status/", hot_page("/objectives/status/", &status_objectives_page, all_modules));
+    server.Get("/objectives/add/", cached_page(&add_objectives_page, none_modules));
     server.Post("/objectives/edit/", &edit_objectives_page);
 
-    server.Get("/wishes/list/", &wishes_list_page);
-    server.Get("/wishes/status/", &wishes_status_page);
-    server.Get("/wishes/estimate/", &wishes_estimate_page);
-    server.Get("/wishes/add/", &add_wishes_page);
+    server.Get("/wishes/list/", cached_page(&wishes_list_page, wishes_modules));
+    server.Get("/wishes/status/", hot_page("/wishes/status/", &wishes_status_page, all_modules));
+    server.Get("/wishes/estimate/", cached_page(&wishes_estimate_page, all_modules));
+    server.Get("/wishes/add/", cached_page(&add_wishes_page, none_modules));
     server.Post("/wishes/edit/", &edit_wishes_page);
 
-    server.Get("/retirement/status/", &retirement_status_page);
-    server.Get("/retirement/configure/", &retirement_configure_page);
-    server.Get("/retirement/fi/", &retirement_fi_ratio_over_time);
+    server.Get("/retirement/status/", hot_page("/retirement/status/", &retirement_status_page, all_modules));
+    server.Get("/retirement/configure/", cached_page(&retirement_configure_page, all_modules));
+    server.Get("/retirement/fi/", hot_page("/retirement/fi/", &retirement_fi_ratio_over_time, all_modules));
 
-    server.Get("/recurrings/list/", &recurrings_list_page);
-    server.Get("/recurrings/add/", &add_recurrings_page);
+    server.Get("/recurrings/list/", cached_page(&recurrings_list_page, recurrings_modules));
+    server.Get("/recurrings/add/", cached_page(&add_recurrings_page, accounts_modules));
     server.Post("/recurrings/edit/", &edit_recurrings_page);
 
-    server.Get("/debts/list/", &budget::list_debts_page);
-    server.Get("/debts/all/", &budget::all_debts_page);
-    server.Get("/debts/add/", &budget::add_debts_page);
+    server.Get("/debts/list/", cached_page(&budget::list_debts_page, debts_modules));
+    server.Get("/debts/all/", cached_page(&budget::all_debts_page, debts_modules));
+    server.Get("/debts/add/", cached_page(&budget::add_debts_page, none_modules));
     server.Post("/debts/edit/", &budget::edit_debts_page);
 
-    server.Get("/fortunes/graph/", &graph_fortunes_page);
-    server.Get("/fortunes/status/", &status_fortunes_page);
-    server.Get("/fortunes/list/", &list_fortunes_page);
-    server.Get("/fortunes/add/", &add_fortunes_page);
+    server.Get("/fortunes/graph/", cached_page(&graph_fortunes_page, fortunes_modules));
+    server.Get("/fortunes/status/", cached_page(&status_fortunes_page, fortunes_modules));
+    server.Get("/fortunes/list/", cached_page(&list_fortunes_page, fortunes_modules));
+    server.Get("/fortunes/add/", cached_page(&add_fortunes_page, none_modules));
     server.Post("/fortunes/edit/", &edit_fortunes_page);
 
     // Handle error
 
     server.set_error_handler([](const auto& req, auto& res) {
-        std::stringstream content_stream;
+        budget::chunked_stream content_stream;
         content_stream.imbue(std::locale("C"));
 
         if (res.status == 401 || res.status == 403) {
-            content_stream << header("", false);
+            write_header(content_stream, "", false);
         } else {
-            content_stream << header("", true);
+            write_header(content_stream, "", true);
         }
 
         content_stream << "<p>Error Status: <span class='text-danger'>";
@@ -566,12 +532,16 @@ void budget::load_pages(httplib::Server& server) {
 
         content_stream << footer();
 
-        res.set_content(content_stream.str(), "text/html");
+        res.set_header("Content-Type", "text/html");
+        content_stream.buffer.move_into(res.body);
     });
 }
 
-bool budget::page_start(const httplib::Request& req, httplib::Response& res, std::stringstream& content_stream, const std::string& title) {
-    content_stream.imbue(std::locale("C"));
+bool budget::authenticate(const httplib::Request& req, httplib::Response& res) {
+    // A pre-rendered page is only stored in the cache
+    if (is_prerendering()) {
+        return true;
+    }
 
     if (is_secure()) {
         if (req.has_header("Authorization")) {
@@ -618,24 +588,142 @@ bool budget::page_start(const httplib::Request& req, httplib::Response& res, std
         }
     }
 
-    content_stream << header(title);
+    return true;
+}
+
+bool budget::page_start(const httplib::Request& req, httplib::Response& res, budget::chunked_stream& content_stream, const std::string& title) {
+    content_stream.imbue(std::locale("C"));
 
-    budget::html_writer w(content_stream);
-    display_message(w, req);
+    if (!authenticate(req, res)) {
+        return false;
+    }
+
+    start_content(req, content_stream, title);
 
     return true;
 }
 
 void budget::page_end(budget::html_writer & w, const httplib::Request& req, httplib::Response& res) {
-    w << "</main>";
-    w.load_deferred_scripts();
-    w << "</body></html>";
+    cpp_unused(req);
+
+    end_content(w);
+
+    auto* buffer = dynamic_cast<budget::chunked_buffer*>(w.os.rdbuf());
+    cpp_assert(buffer, "Pages must be written into a chunked_stream");
+
+    // The buffer is handed to the response, without copying small pages
+    res.set_header("Content-Type", "text/html");
+    buffer->move_into(res.body);
+}
+
+void budget::stream_page(const httplib::Request& req, httplib::Response& res, const std::string& title, std::function<void(budget::html_writer& w)> content) {
+    if (!authenticate(req, res)) {
+        return;
+    }
+
+    // Without a client, the page is rendered directly into the response
+    if (is_prerendering()) {
+        budget::chunked_stream content_stream;
+        content_stream.imbue(std::locale("C"));
+
+        start_content(req, content_stream, title);
+
+        budget::html_writer w(content_stream);
+        content(w);
+
+        page_end(w, req, res);
+        return;
+    }
+
+    // The complete page is only kept when it is going to be cached
+    auto capture = take_page_capture();
+
+    res.set_header("Content-Type", "text/html");
+
+    // The provider is called while the response is written, the request is still alive
+    res.set_chunked_content_provider([&req, title, content, capture](size_t, httplib::DataSink sink, httplib::Done done) {
+        std::string captured;
+
+        budget::chunked_stream content_stream;
+        content_stream.imbue(std::locale("C"));
+
+        content_stream.buffer.set_sink([&sink, &captured, &capture](const char* data, size_t size) {
+            sink(data, size);
+            record_streamed_bytes(size);
+
+            if (capture) {
+                captured.append(data, size);
+            }
+        });
+
+        start_content(req, content_stream, title);
+
+        // The browser can start with the header while the content is computed
+        content_stream.flush();
+
+        budget::html_writer w(content_stream);
+        content(w);
+
+        end_content(w);
+
+        content_stream.flush();
+
+        if (capture) {
+            capture(std::move(captured), "text/html");
+        }
+
+        done();
+    });
+}
+
+void budget::flush_page(budget::html_writer& w) {
+    w.os.flush();
+}
 
-    auto result = w.os.str();
+void budget::render_cards(budget::html_writer& w, const std::vector<std::function<void(budget::html_writer& w)>>& cards) {
+    auto* buffer = dynamic_cast<budget::chunked_buffer*>(w.os.rdbuf());
+    cpp_assert(buffer, "Pages must be written into a chunked_stream");
 
-    filter_html(result, req);
+    struct card_output {
+        budget::chunked_stream stream;
+        budget::html_writer writer{stream};
+    };
 
-    res.set_content(result, "text/html");
+    std::vector<std::unique_ptr<card_output>> outputs;
+    std::vector<std::future<void>> results;
+
+    for (auto& card : cards) {
+        outputs.emplace_back(std::make_unique<card_output>());
+
+        auto& output = *outputs.back();
+        output.stream.imbue(w.os.getloc());
+        output.stream.buffer.copy_placeholders(*buffer);
+
+        results.emplace_back(submit_task([&output, &card]() { card(output.writer); }));
+    }
+
+    for (size_t i = 0; i < cards.size(); ++i) {
+        try {
+            results[i].get();
+        } catch (...) {
+            // The other cards still use the outputs
+            for (size_t j = i + 1; j < cards.size(); ++j) {
+                results[j].wait();
+            }
+
+            throw;
+        }
+
+        auto& output = *outputs[i];
+
+        output.stream.buffer.for_each_chunk([&w](const char* data, size_t size) {
+            w.os.write(data, size);
+        });
+
+        w.merge_deferred(output.writer);
+
+        flush_page(w);
+    }
 }
 
 void budget::make_tables_sortable(budget::html_writer& w){
@@ -651,8 +739,76 @@ void budget::make_tables_sortable(budget::html_writer& w){
     w.use_module("datatables");
 }
 
+void budget::server_side_table(budget::html_writer& w, const std::string& id, const std::string& url, const std::vector<std::string>& columns,
+                               size_t order_column, bool dates) {
+    if (dates) {
+        w << R"=====(<div class="form-inline mb-2">)=====";
+        w << R"=====(<label class="mr-2" for=")=====" << id << R"=====(_start">From</label>)=====";
+        w << R"=====(<input type="date" class="form-control form-control-sm mr-2" id=")=====" << id << R"=====(_start">)=====";
+        w << R"=====(<label class="mr-2" for=")=====" << id << R"=====(_end">To</label>)=====";
+        w << R"=====(<input type="date" class="form-control form-control-sm" id=")=====" << id << R"=====(_end">)=====";
+        w << R"=====(</div>)=====";
+    }
+
+    w << R"=====(<div class="table-responsive">)=====";
+    w << R"=====(<table id=")=====" << id << R"=====(" class="table table-sm small-text">)=====";
+    w << R"=====(<thead><tr>)=====";
+
+    for (auto& column : columns) {
+        if (column == "Edit") {
+            w << R"=====(<th class="not-sortable">)=====" << column << "</th>";
+        } else {
+            w << "<th>" << column << "</th>";
+        }
+    }
+
+    w << R"=====(</tr></thead><tbody></tbody></table>)=====";
+    w << R"=====(</div>)=====";
+
+    // The rows are rendered by the server, with their edit buttons
+    w.use_module("open-iconic");
+    w.use_module("datatables");
+
+    // jQuery slim has no ajax support, the rows are fetched directly
+    std::stringstream ss;
+    ss << "(function(){";
+    ss << "var table = $('#" << id << "').DataTable({";
+    ss << "serverSide: true, processing: true, searchDelay: 400,";
+    ss << "order: [[" << order_column << ", 'desc']],";
+    ss << "columnDefs: [{ targets: 'not-sortable', orderable: false }],";
+    ss << "ajax: function(data, callback) {";
+    ss << "var params = new URLSearchParams();";
+    ss << "params.append('draw', data.draw);";
+    ss << "params.append('start', data.start);";
+    ss << "params.append('length', data.length);";
+    ss << "params.append('search[value]', data.search.value);";
+    ss << "if (data.order.length) {";
+    ss << "params.append('order[0][column]', data.order[0].column);";
+    ss << "params.append('order[0][dir]', data.order[0].dir);";
+    ss << "}";
+    ss << "params.append('back_page', window.location.pathname);";
+
+    if (dates) {
+        ss << "params.append('start_date', $('#" << id << "_start').val());";
+        ss << "params.append('end_date', $('#" << id << "_end').val());";
+    }
+
+    ss << "fetch('" << url << "?' + params.toString(), {credentials: 'same-origin'})";
+    ss << ".then(function(response){ return response.json(); }).then(callback);";
+    ss << "}";
+    ss << "});";
+
+    if (dates) {
+        ss << "$('#" << id << "_start, #" << id << "_end').on('change', function(){ table.draw(); });";
+    }
+
+    ss << "})();";
+
+    w.defer_script(ss.str());
+}
+
 bool budget::page_get_start(const httplib::Request& req, httplib::Response& res,
-                    std::stringstream& content_stream, const std::string& title, std::vector<const char*> parameters) {
+                    budget::chunked_stream& content_stream, const std::string& title, std::vector<const char*> parameters) {
     if (!page_start(req, res, content_stream, title)) {
         return false;
     }
@@ -730,6 +886,32 @@ void budget::add_name_picker(budget::writer& w, const std::string& default_value
     add_text_picker(w, "Name", "input_name", default_value);
 }
 
+void budget::add_suggested_name_picker(budget::html_writer& w, const std::string& url, const std::string& default_value) {
+    add_name_picker(w, default_value);
+
+    w << R"=====(<datalist id="input_name_suggestions"></datalist>)=====";
+
+    std::stringstream script;
+
+    script << "(function(){";
+    script << "var input = document.getElementById('input_name');";
+    script << "var list = document.getElementById('input_name_suggestions');";
+    script << "input.setAttribute('list', 'input_name_suggestions');";
+    script << "input.setAttribute('autocomplete', 'off');";
+    script << "input.addEventListener('input', function(){";
+    script << "if (!input.value) { return; }";
+    script << "fetch('" << url << "?prefix=' + encodeURIComponent(input.value), {credentials: 'same-origin'})";
+    script << ".then(function(response){ return response.json(); })";
+    script << ".then(function(names){";
+    script << "list.innerHTML = '';";
+    script << "names.forEach(function(name){ var option = document.createElement('option'); option.value = name; list.appendChild(option); });";
+    script << "});";
+    script << "});";
+    script << "})();";
+
+    w.defer_script(script.str());
+}
+
 void budget::add_title_picker(budget::writer& w, const std::string& default_value) {
     add_text_picker(w, "Title", "input_title", default_value);
 }
@@ -878,12 +1060,38 @@ std::stringstream budget::start_time_chart(budget::html_writer& w, const std::st
     return ss;
 }
 
+std::string budget::chart_date(budget::date date) {
+    return "Date.UTC(" + std::to_string(date.year()) + "," + std::to_string(date.month().value - 1) + "," + std::to_string(date.day()) + ")";
+}
+
 void budget::end_chart(budget::html_writer& w, std::stringstream& ss) {
     ss << R"=====(});)=====";
 
     w.defer_script(ss.str());
 }
 
+void budget::end_async_chart(budget::html_writer& w, std::stringstream& ss, const std::vector<std::string>& urls) {
+    ss << R"=====(});)=====";
+
+    std::stringstream script;
+    script.imbue(std::locale("C"));
+
+    script << "(function(){";
+    script << "var chart = " << ss.str();
+    script << "var points = Math.max(100, Math.round(2 * chart.plotWidth));";
+    script << "chart.showLoading();";
+
+    for (size_t i = 0; i < urls.size(); ++i) {
+        script << "fetch('" << urls[i] << "?points=' + points, {credentials: 'same-origin'})";
+        script << ".then(function(response){ return response.json(); })";
+        script << ".then(function(data){ chart.series[" << i << "].setData(data); chart.hideLoading(); });";
+    }
+
+    script << "})();";
+
+    w.defer_script(script.str());
+}
+
 void budget::add_account_picker(budget::writer& w, budget::date day, const std::string& default_value) {
     w << R"=====(
             <div class="form-group">
@@ -969,6 +1177,16 @@ void budget::add_integer_picker(budget::writer& w, const std::string& title, con
     w << "</div>";
 }
 
+size_t budget::get_search_limit(const httplib::Request& req) {
+    auto value = req.get_param_value("input_limit");
+
+    if (value.empty() || value.size() > 9 || !std::all_of(value.begin(), value.end(), ::isdigit)) {
+        return default_search_limit;
+    }
+
+    return to_number<size_t>(value);
+}
+
 void budget::add_money_picker(budget::writer& w, const std::string& title, const std::string& name, const std::string& default_value, bool one_line, const std::string& currency) {
     if(!currency.empty()){
         cpp_assert(one_line, "add_money_picker currency only works with one_line");
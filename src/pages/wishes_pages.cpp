@@ -80,7 +80,7 @@ void add_urgency_picker(budget::writer& w, int urgency) {
 } // namespace
 
 void budget::wishes_list_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Objectives List")) {
         return;
     }
@@ -94,7 +94,7 @@ void budget::wishes_list_page(const httplib::Request& req, httplib::Response& re
 }
 
 void budget::wishes_status_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Objectives Status")) {
         return;
     }
@@ -108,7 +108,7 @@ void budget::wishes_status_page(const httplib::Request& req, httplib::Response&
 }
 
 void budget::wishes_estimate_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "Objectives Status")) {
         return;
     }
@@ -122,7 +122,7 @@ void budget::wishes_estimate_page(const httplib::Request& req, httplib::Response
 }
 
 void budget::add_wishes_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
     if (!page_start(req, res, content_stream, "New Wish")) {
         return;
     }
@@ -144,7 +144,7 @@ void budget::add_wishes_page(const httplib::Request& req, httplib::Response& res
 }
 
 void budget::edit_wishes_page(const httplib::Request& req, httplib::Response& res) {
-    std::stringstream content_stream;
+    budget::chunked_stream content_stream;
 
     if (!page_get_start(req, res, content_stream, "Edit Wish", {"input_id", "back_page"})){
         return;
@@ -20,6 +20,7 @@
 #include "budget_exception.hpp"
 #include "expenses.hpp"
 #include "writer.hpp"
+#include "scheduler.hpp"
 
 using namespace budget;
 
@@ -113,6 +114,13 @@ void budget::recurring_module::preload() {
     check_for_recurrings();
 }
 
+void budget::schedule_recurring_jobs(){
+    using namespace std::chrono_literals;
+
+    // The recurrings only change with the month, once per hour is enough
+    budget::schedule_job("recurring", 1h, check_for_recurrings);
+}
+
 void budget::recurring_module::load() {
     // Only need to load in server mode
     if (is_server_mode()) {
@@ -15,6 +15,7 @@
 #include "console.hpp"
 #include "writer.hpp"
 #include "date.hpp"
+#include "monthly_series.hpp"
 
 using namespace budget;
 
@@ -39,6 +40,18 @@ void write(graph_type& graph, int row, int col, const std::string& value) {
     }
 }
 
+using account_series = std::unordered_map<size_t, budget::monthly_series<budget::money>>;
+
+budget::money month_amount(const account_series& series, size_t account, budget::date month) {
+    auto it = series.find(account);
+
+    if (it == series.end() || !it->second.contains(month)) {
+        return {};
+    }
+
+    return it->second[it->second.position(month)];
+}
+
 
 } //end of anonymous namespace
 
@@ -76,6 +89,18 @@ void budget::report(budget::writer& w, budget::year year, bool filter, const std
 
     auto sm = start_month(year);
 
+    // All the months of the report are computed in a single pass
+    account_series expenses_series;
+    account_series earnings_series;
+
+    if (sm <= today.month()) {
+        budget::date first(year, sm, 1);
+        budget::date last(year, today.month(), 1);
+
+        expenses_series = monthly_expenses_by_account(first, last);
+        earnings_series = monthly_earnings_by_account(first, last);
+    }
+
      if (w.is_web()) {
          w << title_begin << "Monthly report of " + to_string(year) << title_end;
 
@@ -103,8 +128,8 @@ void budget::report(budget::writer& w, budget::year year, bool filter, const std
 
              for (auto& account : all_accounts(year, month)) {
                  if (!filter || account.name == filter_account) {
-                     auto expenses = accumulate_amount(all_expenses_month(account.id, year, month));
-                     auto earnings = accumulate_amount(all_earnings_month(account.id, year, month));
+                     auto expenses = month_amount(expenses_series, account.id, {year, month, 1});
+                     auto earnings = month_amount(earnings_series, account.id, {year, month, 1});
 
                      m_expenses += expenses;
                      m_earnings += earnings;
@@ -142,10 +167,8 @@ void budget::report(budget::writer& w, budget::year year, bool filter, const std
 
         for (auto& account : all_accounts(year, month)) {
             if (!filter || account.name == filter_account) {
-                auto expenses = accumulate_amount_if(all_expenses(),
-                                                     [year, month, account](const budget::expense& e) { return e.account == account.id && e.date.year() == year && e.date.month() == month; });
-                auto earnings = accumulate_amount_if(all_earnings(),
-                                                     [year, month, account](const budget::earning& e) { return e.account == account.id && e.date.year() == year && e.date.month() == month; });
+                auto expenses = month_amount(expenses_series, account.id, {year, month, 1});
+                auto earnings = month_amount(earnings_series, account.id, {year, month, 1});
 
                 total_expenses += expenses;
                 total_earnings += earnings;
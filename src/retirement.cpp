@@ -18,6 +18,7 @@
 #include "console.hpp"
 #include "writer.hpp"
 #include "incomes.hpp"
+#include "monthly_series.hpp"
 
 using namespace budget;
 
@@ -25,48 +26,48 @@ namespace {
 
 constexpr size_t running_limit = 12;
 
-money running_expenses(budget::date d = budget::local_day()){
-    budget::date end = d - budget::days(d.day() - 1);
-    budget::date start = end - budget::months(running_limit);
+// The expenses of the running_limit months before each month from first to last
+monthly_series<money> running_expenses_series(budget::date first, budget::date last){
+    budget::date start = budget::date(first.year(), first.month(), 1) - budget::months(running_limit);
 
-    budget::money total;
+    auto monthly = monthly_expenses(start, last);
 
-    for(auto& expense : all_expenses()){
-        if(expense.date >= start && expense.date < end){
-            total += expense.amount;
-        }
-    }
+    monthly_series<money> running(first, last);
 
-    return total;
-}
+    // The sum of the window slides one month at a time
+    budget::money sum;
 
-double running_savings_rate(budget::date sd = budget::local_day()){
-    double savings_rate = 0.0;
+    for (size_t i = 0; i < monthly.size(); ++i) {
+        if (i >= running_limit) {
+            running[i - running_limit] = sum;
+            sum -= monthly[i - running_limit];
+        }
 
-    for(size_t i = 1; i <= running_limit; ++i){
-        auto d = sd - budget::months(i);
+        sum += monthly[i];
+    }
 
-        budget::money expenses;
+    return running;
+}
 
-        for (auto& expense : all_expenses()) {
-            if (expense.date.year() == d.year() && expense.date.month() == d.month()) {
-                expenses += expense.amount;
-            }
-        }
+money running_expenses(budget::date d = budget::local_day()){
+    return running_expenses_series(d, d)[0];
+}
 
-        budget::money earnings;
+double running_savings_rate(budget::date sd = budget::local_day()){
+    auto first = sd - budget::months(running_limit);
+    auto last  = sd - budget::months(1);
 
-        for (auto& earning : all_earnings()) {
-            if (earning.date.year() == d.year() && earning.date.month() == d.month()) {
-                earnings += earning.amount;
-            }
-        }
+    auto all_expenses = monthly_expenses(first, last);
+    auto all_earnings = monthly_earnings(first, last);
+    auto all_income   = monthly_budget(first, last);
 
-        budget::money income;
+    double savings_rate = 0.0;
 
-        for (auto& account : all_accounts(d.year(), d.month())){
-            income += account.amount;
-        }
+    // From the most recent month
+    for(size_t i = running_limit; i > 0; --i){
+        auto expenses = all_expenses[i - 1];
+        auto earnings = all_earnings[i - 1];
+        auto income   = all_income[i - 1];
 
         auto balance = income + earnings - expenses;
         auto local   = balance / (income + earnings);
@@ -140,6 +141,24 @@ float budget::fi_ratio(budget::date d) {
     return nw / missing;
 }
 
+std::vector<float> budget::fi_ratio_series(budget::date first, budget::date last) {
+    auto wrate    = to_number<double>(internal_config_value("withdrawal_rate"));
+    auto years    = double(int(100.0 / wrate));
+    auto expenses = running_expenses_series(first, last);
+    auto nw       = get_net_worth_series(first, last);
+
+    std::vector<float> series(nw.size());
+
+    size_t i = 0;
+    for (auto d = first; d <= last; d += days(1), ++i) {
+        auto missing = years * expenses[expenses.position(d)] - nw[i];
+
+        series[i] = nw[i] / missing;
+    }
+
+    return series;
+}
+
 void budget::retirement_status(budget::writer& w) {
     if (!w.is_web()) {
         if (!internal_config_contains("withdrawal_rate")) {
@@ -0,0 +1,290 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <deque>
+#include <memory>
+#include <random>
+#include <unordered_map>
+
+#include "scheduler.hpp"
+#include "budget_exception.hpp"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct job {
+    std::function<void()> function;
+    std::chrono::seconds jitter;
+    bool running = false;
+    budget::job_metrics metrics;
+
+    bool once    = false;       ///< Indicates that the job does not repeat
+    bool pending = false;       ///< Indicates that a run of the job is waiting in the timers
+    clock_type::time_point due; ///< The time the job must run, when it is not repeated
+};
+
+struct timer {
+    clock_type::time_point base; ///< The time the job is due, without jitter
+    clock_type::time_point next; ///< The time the job will run
+    size_t job;
+
+    friend bool operator>(const timer& lhs, const timer& rhs){
+        return lhs.next > rhs.next;
+    }
+};
+
+// Protects all the state of the scheduler
+std::mutex scheduler_lock;
+
+std::condition_variable timers_condition;
+std::condition_variable ready_condition;
+
+// The jobs are never removed, timers and the ready queue refer to them by index
+std::vector<std::unique_ptr<job>> jobs;
+std::priority_queue<timer, std::vector<timer>, std::greater<timer>> timers;
+std::deque<size_t> ready;
+
+// The jobs that are not repeated, by name
+std::unordered_map<std::string, size_t> once_jobs;
+
+std::vector<std::thread> threads;
+bool stopping = false;
+
+std::mt19937_64 generator{std::random_device{}()};
+
+clock_type::duration random_jitter(const job& job){
+    if (!job.jitter.count()) {
+        return clock_type::duration::zero();
+    }
+
+    std::uniform_int_distribution<long> distribution(0, std::chrono::milliseconds(job.jitter).count());
+    return std::chrono::milliseconds(distribution(generator));
+}
+
+// Sleeps until the next timer is due and hands the job to the workers
+void timers_loop(){
+    std::unique_lock<std::mutex> lock(scheduler_lock);
+
+    while (!stopping) {
+        if (timers.empty()) {
+            timers_condition.wait(lock);
+            continue;
+        }
+
+        if (clock_type::now() < timers.top().next) {
+            timers_condition.wait_until(lock, timers.top().next);
+            continue;
+        }
+
+        auto timer = timers.top();
+        timers.pop();
+
+        auto& job = *jobs[timer.job];
+
+        if (job.once) {
+            // The job has been delayed again since this timer was pushed
+            if (timer.next < job.due) {
+                timer.base = timer.next = job.due;
+                timers.push(timer);
+                continue;
+            }
+
+            // The data may have changed during the run, so this run is postponed
+            if (job.running) {
+                timer.base = timer.next = job.due = clock_type::now() + std::chrono::seconds(1);
+                timers.push(timer);
+                continue;
+            }
+
+            job.pending = false;
+            job.running = true;
+
+            ready.push_back(timer.job);
+            ready_condition.notify_one();
+
+            continue;
+        }
+
+        if (job.running) {
+            ++job.metrics.overruns;
+
+            std::cout << "INFO: Scheduler: Job " << job.metrics.name << " is still running, skipping this run" << std::endl;
+        } else {
+            job.running = true;
+
+            ready.push_back(timer.job);
+            ready_condition.notify_one();
+        }
+
+        // Missed runs are not made up for
+        auto now = clock_type::now();
+
+        timer.base += job.metrics.period;
+        if (timer.base < now) {
+            timer.base = now + job.metrics.period;
+        }
+
+        timer.next = timer.base + random_jitter(job);
+
+        timers.push(timer);
+    }
+}
+
+void worker_loop(){
+    std::unique_lock<std::mutex> lock(scheduler_lock);
+
+    while (true) {
+        ready_condition.wait(lock, [](){ return stopping || !ready.empty(); });
+
+        if (stopping) {
+            return;
+        }
+
+        auto& job = *jobs[ready.front()];
+        ready.pop_front();
+
+        lock.unlock();
+
+        bool failed = false;
+        auto start  = clock_type::now();
+
+        try {
+            job.function();
+        } catch (const budget::budget_exception& e) {
+            std::cout << "ERROR: Scheduler: Job " << job.metrics.name << " failed: " << e.message() << std::endl;
+            failed = true;
+        } catch (const std::exception& e) {
+            std::cout << "ERROR: Scheduler: Job " << job.metrics.name << " failed: " << e.what() << std::endl;
+            failed = true;
+        } catch (...) {
+            std::cout << "ERROR: Scheduler: Job " << job.metrics.name << " failed with an unknown exception" << std::endl;
+            failed = true;
+        }
+
+        auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(clock_type::now() - start);
+
+        lock.lock();
+
+        auto& metrics = job.metrics;
+
+        ++metrics.runs;
+        metrics.failures += failed;
+        metrics.last_latency = latency;
+        metrics.max_latency = std::max(metrics.max_latency, latency);
+        metrics.total_latency += latency;
+
+        job.running = false;
+    }
+}
+
+} // end of anonymous namespace
+
+void budget::schedule_job(const std::string& name, std::chrono::seconds period, std::function<void()> function, std::chrono::seconds delay, std::chrono::seconds jitter){
+    std::lock_guard<std::mutex> lock(scheduler_lock);
+
+    auto new_job = std::make_unique<job>();
+    new_job->function       = std::move(function);
+    new_job->jitter         = jitter;
+    new_job->metrics.name   = name;
+    new_job->metrics.period = period;
+
+    jobs.push_back(std::move(new_job));
+
+    auto base = clock_type::now() + delay;
+    timers.push({base, base, jobs.size() - 1});
+
+    timers_condition.notify_one();
+}
+
+void budget::schedule_once(const std::string& name, std::chrono::seconds delay, std::function<void()> function){
+    std::lock_guard<std::mutex> lock(scheduler_lock);
+
+    auto it = once_jobs.find(name);
+
+    // The function cannot be replaced, the job may be running
+    if (it == once_jobs.end()) {
+        auto new_job = std::make_unique<job>();
+        new_job->function       = std::move(function);
+        new_job->jitter         = std::chrono::seconds(0);
+        new_job->once           = true;
+        new_job->metrics.name   = name;
+        new_job->metrics.period = std::chrono::seconds(0);
+
+        jobs.push_back(std::move(new_job));
+
+        it = once_jobs.emplace(name, jobs.size() - 1).first;
+    }
+
+    auto& job = *jobs[it->second];
+    job.due   = clock_type::now() + delay;
+
+    // A pending timer finds the new time when it is due
+    if (!job.pending) {
+        job.pending = true;
+
+        timers.push({job.due, job.due, it->second});
+        timers_condition.notify_one();
+    }
+}
+
+void budget::start_scheduler(size_t workers){
+    std::lock_guard<std::mutex> lock(scheduler_lock);
+
+    stopping = false;
+
+    threads.emplace_back(timers_loop);
+
+    for (size_t i = 0; i < workers; ++i) {
+        threads.emplace_back(worker_loop);
+    }
+
+    std::cout << "INFO: Scheduler: Started with " << jobs.size() << " jobs and " << workers << " workers" << std::endl;
+}
+
+void budget::stop_scheduler(){
+    {
+        std::lock_guard<std::mutex> lock(scheduler_lock);
+
+        stopping = true;
+
+        // The pending runs are dropped
+        for (auto index : ready) {
+            jobs[index]->running = false;
+        }
+
+        ready.clear();
+    }
+
+    timers_condition.notify_all();
+    ready_condition.notify_all();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    threads.clear();
+
+    std::cout << "INFO: Scheduler: Stopped" << std::endl;
+}
+
+std::vector<budget::job_metrics> budget::scheduler_metrics(){
+    std::lock_guard<std::mutex> lock(scheduler_lock);
+
+    std::vector<budget::job_metrics> metrics;
+
+    for (auto& job : jobs) {
+        metrics.push_back(job->metrics);
+    }
+
+    return metrics;
+}
@@ -0,0 +1,259 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <tuple>
+#include <cctype>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+
+#include "search_index.hpp"
+#include "data.hpp"
+#include "expenses.hpp"
+#include "earnings.hpp"
+
+namespace {
+
+using trigram = uint32_t;
+
+struct indexed_name {
+    std::string name;  ///< The name of the entry
+    std::string lower; ///< The name in lower case
+};
+
+/*
+ * An inverted index of the trigrams of the names of a module.
+ *
+ * The postings are sorted ids of entries. The index is updated on the first
+ * search after a change of the data: only the names of the entries added,
+ * removed or renamed are indexed again.
+ */
+struct name_index {
+    std::unordered_map<size_t, indexed_name> names; ///< By id of the entry
+    std::unordered_map<size_t, size_t> positions;   ///< The position in the data, by id of the entry
+    std::unordered_map<trigram, std::vector<size_t>> postings;
+};
+
+budget::generation_cache<name_index> expenses_index{"expenses"};
+budget::generation_cache<name_index> earnings_index{"earnings"};
+
+std::string lower_case(const std::string& value){
+    auto lower = value;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    return lower;
+}
+
+// The distinct trigrams of the string, sorted
+std::vector<trigram> trigrams(const std::string& value){
+    std::vector<trigram> result;
+
+    for (size_t i = 0; i + 2 < value.size(); ++i) {
+        result.push_back(trigram(uint8_t(value[i])) << 16 | trigram(uint8_t(value[i + 1])) << 8 | trigram(uint8_t(value[i + 2])));
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+
+    return result;
+}
+
+void add_postings(name_index& index, size_t id, const std::string& lower){
+    for (auto t : trigrams(lower)) {
+        auto& posting = index.postings[t];
+
+        // The ids are increasing, the new entries are added at the end
+        if (posting.empty() || posting.back() < id) {
+            posting.push_back(id);
+        } else {
+            posting.insert(std::lower_bound(posting.begin(), posting.end(), id), id);
+        }
+    }
+}
+
+void remove_postings(name_index& index, size_t id, const std::string& lower){
+    for (auto t : trigrams(lower)) {
+        auto it = index.postings.find(t);
+        auto& posting = it->second;
+
+        posting.erase(std::lower_bound(posting.begin(), posting.end(), id));
+
+        if (posting.empty()) {
+            index.postings.erase(it);
+        }
+    }
+}
+
+template <typename Data>
+void update_index(name_index& index, const Data& data){
+    index.positions.clear();
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        auto& entry = data[i];
+
+        index.positions[entry.id] = i;
+
+        auto it = index.names.find(entry.id);
+
+        if (it != index.names.end()) {
+            if (it->second.name == entry.name) {
+                continue;
+            }
+
+            remove_postings(index, entry.id, it->second.lower);
+        }
+
+        indexed_name name{entry.name, lower_case(entry.name)};
+        add_postings(index, entry.id, name.lower);
+        index.names[entry.id] = std::move(name);
+    }
+
+    // The entries that have been removed
+    for (auto it = index.names.begin(); it != index.names.end();) {
+        if (!index.positions.count(it->first)) {
+            remove_postings(index, it->first, it->second.lower);
+            it = index.names.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// The ids of the entries containing all the trigrams of the terms
+std::vector<size_t> candidates(const name_index& index, const std::vector<std::string>& terms){
+    std::vector<const std::vector<size_t>*> lists;
+
+    for (auto& term : terms) {
+        for (auto t : trigrams(term)) {
+            auto it = index.postings.find(t);
+
+            if (it == index.postings.end()) {
+                return {};
+            }
+
+            lists.push_back(&it->second);
+        }
+    }
+
+    std::vector<size_t> result;
+
+    // Without any trigram, all the entries must be verified
+    if (lists.empty()) {
+        for (auto& name : index.names) {
+            result.push_back(name.first);
+        }
+
+        return result;
+    }
+
+    // The intersection starts from the shortest list
+    std::sort(lists.begin(), lists.end(), [](auto* lhs, auto* rhs) { return lhs->size() < rhs->size(); });
+
+    result = *lists.front();
+
+    for (size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+        std::vector<size_t> next;
+        std::set_intersection(result.begin(), result.end(), lists[i]->begin(), lists[i]->end(), std::back_inserter(next));
+        result = std::move(next);
+    }
+
+    return result;
+}
+
+bool starts_word(const std::string& lower, const std::string& term){
+    for (auto pos = lower.find(term); pos != std::string::npos; pos = lower.find(term, pos + 1)) {
+        if (pos == 0 || !std::isalnum(static_cast<unsigned char>(lower[pos - 1]))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// 0 for the exact names, 1 for the prefixes, 2 for the word prefixes and 3 for the others
+int rank(const std::string& lower, const std::string& query, const std::vector<std::string>& terms){
+    if (lower == query) {
+        return 0;
+    }
+
+    if (lower.compare(0, query.size(), query) == 0) {
+        return 1;
+    }
+
+    for (auto& term : terms) {
+        if (starts_word(lower, term)) {
+            return 2;
+        }
+    }
+
+    return 3;
+}
+
+template <typename Data>
+std::vector<size_t> search_index(budget::generation_cache<name_index>& cache, const Data& data, const std::string& query, size_t limit){
+    std::vector<std::string> terms;
+    for (auto& term : budget::split(lower_case(query), ' ')) {
+        if (!term.empty()) {
+            terms.push_back(term);
+        }
+    }
+
+    std::string normalized_query;
+    for (auto& term : terms) {
+        normalized_query += normalized_query.empty() ? term : " " + term;
+    }
+
+    auto update = [&data](name_index& index) { update_index(index, data); };
+
+    // The hits, sorted by rank, then by date, the most recent first
+    auto hits = cache.access(update, [&](name_index& index) {
+        std::vector<std::tuple<int, budget::date, size_t>> matches;
+
+        for (auto id : candidates(index, terms)) {
+            auto& lower = index.names[id].lower;
+
+            bool match = std::all_of(terms.begin(), terms.end(), [&lower](const std::string& term) { return lower.find(term) != std::string::npos; });
+
+            if (match) {
+                auto position = index.positions[id];
+                matches.emplace_back(rank(lower, normalized_query, terms), data[position].date, position);
+            }
+        }
+
+        return matches;
+    });
+
+    auto compare = [](auto& lhs, auto& rhs) {
+        return std::get<0>(lhs) != std::get<0>(rhs) ? std::get<0>(lhs) < std::get<0>(rhs)
+             : std::get<1>(lhs) != std::get<1>(rhs) ? std::get<1>(lhs) > std::get<1>(rhs)
+             : std::get<2>(lhs) < std::get<2>(rhs);
+    };
+
+    if (limit && limit < hits.size()) {
+        std::partial_sort(hits.begin(), hits.begin() + limit, hits.end(), compare);
+        hits.resize(limit);
+    } else {
+        std::sort(hits.begin(), hits.end(), compare);
+    }
+
+    std::vector<size_t> result;
+
+    for (auto& hit : hits) {
+        result.push_back(std::get<2>(hit));
+    }
+
+    return result;
+}
+
+} // end of anonymous namespace
+
+std::vector<size_t> budget::search_expenses_index(const std::string& query, size_t limit){
+    return search_index(expenses_index, all_expenses(), query, limit);
+}
+
+std::vector<size_t> budget::search_earnings_index(const std::string& query, size_t limit){
+    return search_index(earnings_index, all_earnings(), query, limit);
+}
@@ -0,0 +1,133 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+
+#include "series.hpp"
+
+std::vector<budget::series_point> budget::downsample_lttb(const std::vector<series_point>& points, size_t threshold){
+    if (threshold >= points.size() || threshold < 3) {
+        return points;
+    }
+
+    std::vector<series_point> sampled;
+    sampled.reserve(threshold);
+
+    // The first and last points are always kept, the others are split in buckets
+    const double every = double(points.size() - 2) / double(threshold - 2);
+
+    size_t a = 0;
+    sampled.push_back(points.front());
+
+    for (size_t i = 0; i < threshold - 2; ++i) {
+        // The average point of the next bucket is the third point of the triangle
+
+        size_t avg_start = size_t(std::floor((i + 1) * every)) + 1;
+        size_t avg_end   = std::min(size_t(std::floor((i + 2) * every)) + 1, points.size());
+
+        double avg_x = 0;
+        double avg_y = 0;
+
+        for (size_t j = avg_start; j < avg_end; ++j) {
+            avg_x += points[j].x;
+            avg_y += points[j].y;
+        }
+
+        avg_x /= double(avg_end - avg_start);
+        avg_y /= double(avg_end - avg_start);
+
+        // Select the point of the current bucket with the largest triangle
+
+        size_t range_start = size_t(std::floor(i * every)) + 1;
+        size_t range_end   = size_t(std::floor((i + 1) * every)) + 1;
+
+        const double a_x = points[a].x;
+        const double a_y = points[a].y;
+
+        double max_area = -1.0;
+        size_t next     = range_start;
+
+        for (size_t j = range_start; j < range_end; ++j) {
+            double area = std::abs((a_x - avg_x) * (points[j].y - a_y) - (a_x - points[j].x) * (avg_y - a_y));
+
+            if (area > max_area) {
+                max_area = area;
+                next     = j;
+            }
+        }
+
+        sampled.push_back(points[next]);
+        a = next;
+    }
+
+    sampled.push_back(points.back());
+
+    return sampled;
+}
+
+std::vector<budget::series_point> budget::downsample_min_max(const std::vector<series_point>& points, size_t threshold){
+    if (threshold >= points.size() || threshold < 4) {
+        return points;
+    }
+
+    std::vector<series_point> sampled;
+    sampled.reserve(threshold);
+
+    // Each bucket gives two points, the first and last points are always kept
+    const size_t buckets = (threshold - 2) / 2;
+    const double every   = double(points.size() - 2) / double(buckets);
+
+    sampled.push_back(points.front());
+
+    for (size_t i = 0; i < buckets; ++i) {
+        auto first = points.begin() + size_t(i * every) + 1;
+        auto last  = points.begin() + std::min(size_t((i + 1) * every) + 1, points.size() - 1);
+
+        if (first >= last) {
+            continue;
+        }
+
+        auto extremes = std::minmax_element(first, last, [](const series_point& lhs, const series_point& rhs) { return lhs.y < rhs.y; });
+
+        // The points must stay in order of time
+        auto low  = std::min(extremes.first, extremes.second);
+        auto high = std::max(extremes.first, extremes.second);
+
+        sampled.push_back(*low);
+
+        if (high != low) {
+            sampled.push_back(*high);
+        }
+    }
+
+    sampled.push_back(points.back());
+
+    return sampled;
+}
+
+std::string budget::series_to_json(const std::vector<series_point>& points){
+    std::stringstream ss;
+    ss.imbue(std::locale("C"));
+    ss << std::fixed << std::setprecision(2);
+
+    ss << '[';
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (i) {
+            ss << ',';
+        }
+
+        ss << '[' << points[i].x << ',' << points[i].y << ']';
+    }
+
+    ss << ']';
+
+    return ss.str();
+}
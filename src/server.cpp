@@ -24,10 +24,14 @@
 #include "debts.hpp"
 #include "currency.hpp"
 #include "share.hpp"
+#include "scheduler.hpp"
+#include "task_pool.hpp"
 #include "http.hpp"
+#include "column_kernels.hpp"
 
 #include "api/server_api.hpp"
 #include "pages/server_pages.hpp"
+#include "pages/page_cache.hpp"
 
 using namespace budget;
 
@@ -36,13 +40,11 @@ namespace {
 bool server_running = false;
 
 httplib::Server * server_ptr = nullptr;
-volatile bool cron = true;
 
 void server_signal_handler(int signum) {
     std::cout << "INFO: Received signal (" << signum << ")" << std::endl;
 
-    cron = false;
-
+    // The scheduler is stopped once the server has exited
     if (server_ptr) {
         server_ptr->stop();
     }
@@ -64,11 +66,21 @@ void start_server(){
 
     httplib::Server server;
 
-    load_pages(server);
-    load_api(server);
+    metered_server metered(server);
+
+    load_pages(metered);
+    load_api(metered);
+
+    // The metrics of a request are complete once its response is written
+    server.set_logger(&finish_request);
+
+    // The first requests do not have to wait for the hot pages
+    prerender_hot_pages();
 
     install_signal_handler();
 
+    std::cout << "INFO: Using the " << best_column_kernels().name << " aggregation kernels" << std::endl;
+
     auto port = get_server_port();
     auto listen = get_server_listen();
     server_ptr = &server;
@@ -79,37 +91,6 @@ void start_server(){
     std::cout << "INFO: Server has exited" << std::endl;
 }
 
-void start_cron_loop(){
-    std::cout << "INFO: Started the cron thread" << std::endl;
-    size_t seconds = 0;
-
-    while(cron){
-        using namespace std::chrono_literals;
-
-        std::this_thread::sleep_for(1s);
-        ++seconds;
-
-        check_for_recurrings();
-
-        auto hours = seconds / 3600;
-
-        // We save the cache once per day
-        if (hours && hours % 24 == 0) {
-            save_currency_cache();
-            save_share_price_cache();
-        }
-
-        // Every four hours, we refresh the currency cache
-        // Only current day rates are refreshed
-        if (hours && hours % 4 == 0) {
-            std::cout << "Refresh the currency cache" << std::endl;
-            budget::refresh_currency_cache();
-        }
-    }
-
-    std::cout << "INFO: Cron Thread has exited" << std::endl;
-}
-
 } //end of anonymous namespace
 
 void budget::set_server_running(){
@@ -136,11 +117,20 @@ void budget::server_module::handle(const std::vector<std::string>& args){
 
     std::cout << "Starting the threads" << std::endl;
 
+    schedule_recurring_jobs();
+    schedule_currency_jobs();
+    schedule_share_jobs();
+    schedule_hot_pages_rollover();
+
+    start_scheduler();
+    start_task_pool();
+
     std::thread server_thread([](){ start_server(); });
-    std::thread cron_thread([](){ start_cron_loop(); });
 
     server_thread.join();
-    cron_thread.join();
+
+    stop_task_pool();
+    stop_scheduler();
 }
 
 bool budget::is_server_running(){
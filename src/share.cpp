@@ -8,12 +8,18 @@
 #include <tuple>
 #include <utility>
 #include <iostream>
+#include <cstdio>
+#include <cstdint>
+#include <mutex>
 
 #include "share.hpp"
 #include "config.hpp"
 #include "server.hpp"
 #include "http.hpp"
 #include "date.hpp"
+#include "scheduler.hpp"
+#include "data.hpp"
+#include "metrics.hpp"
 
 namespace {
 
@@ -34,6 +40,188 @@ struct share_price_cache_key {
 
 std::map<share_price_cache_key, double> share_prices;
 
+// Protects share_prices, the histories and the cache log
+std::mutex share_prices_lock;
+
+// The cache file is an append-only log, the last line of a key wins.
+// It is compacted from time to time to drop the superseded lines.
+size_t share_prices_log_lines = 0;
+
+void write_cache_entry(std::ostream& file, const share_price_cache_key& key, double price){
+    file << budget::date_to_string(key.date) << ':' << key.ticker << ':' << price << '\n';
+}
+
+// Must be called with share_prices_lock held
+void append_cache_entry(const share_price_cache_key& key, double price){
+    std::ofstream file(budget::path_to_budget_file("share_price.cache"), std::ios::app);
+
+    if (!file.is_open() || !file.good()){
+        std::cout << "ERROR: Impossible to append to Share Price Cache" << std::endl;
+        return;
+    }
+
+    file.imbue(std::locale::classic());
+    write_cache_entry(file, key, price);
+
+    ++share_prices_log_lines;
+}
+
+bool cached_share_price(const share_price_cache_key& key, double& price){
+    std::lock_guard<std::mutex> lock(share_prices_lock);
+
+    auto it = share_prices.find(key);
+    if (it != share_prices.end()) {
+        price = it->second;
+        return true;
+    }
+
+    return false;
+}
+
+// The history of the closing prices of a ticker, stored column-wise
+struct price_series {
+    std::vector<int32_t> days;  // The day numbers, sorted
+    std::vector<double> closes; // The closing price of each day
+
+    long backfilled = 0;        // The last trading day of the last backfill
+
+    bool covers(int32_t day) const {
+        return !days.empty() && days.front() <= day && day <= days.back();
+    }
+
+    // The closing price of the day, or of the last trading day before it
+    double price(int32_t day) const {
+        auto it = std::upper_bound(days.begin(), days.end(), day);
+        return closes[std::distance(days.begin(), it) - 1];
+    }
+};
+
+// The header of the .series files
+struct price_series_header {
+    char magic[4];
+    uint32_t version;
+    uint64_t size;
+};
+
+constexpr const uint32_t price_series_version = 1;
+
+std::map<std::string, price_series> share_histories;
+
+// The ticker is part of the file name, it must not lead outside of the budget directory
+bool valid_ticker(const std::string& ticker){
+    return !ticker.empty() && ticker.find('/') == std::string::npos && ticker.find('\\') == std::string::npos && ticker.find("..") == std::string::npos;
+}
+
+// Must only be called with a valid ticker
+std::string price_series_path(const std::string& ticker){
+    return budget::path_to_budget_file("share_price_" + ticker + ".series");
+}
+
+bool load_price_series(const std::string& ticker, price_series& series){
+    if (!valid_ticker(ticker)) {
+        std::cout << "ERROR: Price(v1): Invalid ticker " << ticker << std::endl;
+        return false;
+    }
+
+    std::ifstream file(price_series_path(ticker), std::ios::binary | std::ios::ate);
+
+    if (!file.is_open() || !file.good()) {
+        return false;
+    }
+
+    const uint64_t file_size = file.tellg();
+    file.seekg(0);
+
+    price_series_header header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    if (!file || std::string(header.magic, 4) != "BWPS" || header.version != price_series_version) {
+        std::cout << "ERROR: Price(v1): Invalid price series for " << ticker << std::endl;
+        return false;
+    }
+
+    // The size is checked before allocating anything for the columns
+    constexpr const uint64_t entry_size = sizeof(int32_t) + sizeof(double);
+
+    if (header.size > (file_size - sizeof(header)) / entry_size || header.size * entry_size != file_size - sizeof(header)) {
+        std::cout << "ERROR: Price(v1): Truncated price series for " << ticker << std::endl;
+        return false;
+    }
+
+    series.days.resize(header.size);
+    series.closes.resize(header.size);
+
+    // Each column is loaded with a single read
+    file.read(reinterpret_cast<char*>(series.days.data()), header.size * sizeof(int32_t));
+    file.read(reinterpret_cast<char*>(series.closes.data()), header.size * sizeof(double));
+
+    if (!file) {
+        std::cout << "ERROR: Price(v1): Truncated price series for " << ticker << std::endl;
+
+        series.days.clear();
+        series.closes.clear();
+
+        return false;
+    }
+
+    return true;
+}
+
+void save_price_series(const std::string& ticker, const price_series& series){
+    if (!valid_ticker(ticker)) {
+        std::cout << "ERROR: Price(v1): Invalid ticker " << ticker << std::endl;
+        return;
+    }
+
+    auto file_path = price_series_path(ticker);
+    auto tmp_path  = file_path + ".tmp";
+
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+
+        if (!file.is_open() || !file.good()) {
+            std::cout << "ERROR: Price(v1): Impossible to save price series to " << file_path << std::endl;
+            return;
+        }
+
+        price_series_header header{{'B', 'W', 'P', 'S'}, price_series_version, series.days.size()};
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(series.days.data()), series.days.size() * sizeof(int32_t));
+        file.write(reinterpret_cast<const char*>(series.closes.data()), series.closes.size() * sizeof(double));
+    }
+
+    // Make sure we never leave a partially written series
+    std::rename(tmp_path.c_str(), file_path.c_str());
+}
+
+// Must be called with share_prices_lock held
+price_series& get_price_series(const std::string& ticker){
+    if (!share_histories.count(ticker)) {
+        load_price_series(ticker, share_histories[ticker]);
+    }
+
+    return share_histories[ticker];
+}
+
+// A stand-in server (for instance for tests) can be configured
+// with iex_cloud_host and iex_cloud_port, it is then used over plain http
+std::shared_ptr<httplib::Response> iex_get(const std::string& api){
+    auto host = budget::config_value("iex_cloud_host", "cloud.iexapis.com");
+
+    budget::scoped_duration timer("budget_fetch_duration_seconds", budget::metric_label("service", "iex_cloud"));
+
+    if (budget::config_contains("iex_cloud_port")) {
+        httplib::Client cli(host.c_str(), budget::to_number<int>(budget::config_value("iex_cloud_port")));
+
+        return cli.Get(api.c_str());
+    } else {
+        httplib::SSLClient cli(host.c_str(), 443);
+
+        return cli.Get(api.c_str());
+    }
+}
+
 budget::date get_valid_date(budget::date d){
     // We cannot get closing price in the future, so we use the day before date
     if (d >= budget::local_day()) {
@@ -69,12 +257,10 @@ double get_share_price_v1(const std::string& quote, const budget::date& date, in
 
     auto token = budget::config_value("iex_cloud_token");
 
-    httplib::SSLClient cli("cloud.iexapis.com", 443);
-
     auto date_str = budget::date_to_string(date);
     std::string api_complete = "/beta/stock/" + quote + "/chart/date/" + date_str + "?chartByDay=true&token=" + token;
 
-    auto res = cli.Get(api_complete.c_str());
+    auto res = iex_get(api_complete);
 
     if (!res) {
         std::cout << "ERROR: Price(v1): No response" << std::endl;
@@ -96,9 +282,9 @@ double get_share_price_v1(const std::string& quote, const budget::date& date, in
                 std::cout << "INFO: Date was " << date << " retrying with " << next_date << std::endl;
 
                 // Opportunistically check the cache for previous day!
-                share_price_cache_key key(next_date, quote);
-                if (share_prices.count(key)) {
-                    return share_prices[key];
+                double price;
+                if (cached_share_price(share_price_cache_key(next_date, quote), price)) {
+                    return price;
                 } else {
                     return get_share_price_v1(quote, next_date, depth + 1);
                 }
@@ -126,8 +312,159 @@ double get_share_price_v1(const std::string& quote, const budget::date& date, in
     }
 }
 
+// Fetch all the closing prices since the given date, in one request
+bool get_share_price_history_v1(const std::string& quote, const budget::date& date, price_series& series) {
+    if (!budget::config_contains("iex_cloud_token")) {
+        std::cout << "ERROR: Price(v1): Need IEX cloud token configured to work" << std::endl;
+
+        return false;
+    }
+
+    auto token = budget::config_value("iex_cloud_token");
+
+    // Select the smallest range that covers the date
+    auto age = budget::day_number(budget::local_day()) - budget::day_number(date);
+
+    std::string range = "max";
+    if (age < 28) {
+        range = "1m";
+    } else if (age < 90) {
+        range = "3m";
+    } else if (age < 180) {
+        range = "6m";
+    } else if (age < 365) {
+        range = "1y";
+    } else if (age < 2 * 365) {
+        range = "2y";
+    } else if (age < 5 * 365) {
+        range = "5y";
+    }
+
+    std::string api_complete = "/beta/stock/" + quote + "/chart/" + range + "?chartCloseOnly=true&token=" + token;
+
+    auto res = iex_get(api_complete);
+
+    if (!res) {
+        std::cout << "ERROR: Price(v1): No response" << std::endl;
+        std::cout << "ERROR: Price(v1): URL is " << api_complete << std::endl;
+
+        return false;
+    } else if (res->status != 200) {
+        std::cout << "ERROR: Price(v1): Error response " << res->status << std::endl;
+        std::cout << "ERROR: Price(v1): URL is " << api_complete << std::endl;
+
+        return false;
+    }
+
+    // Example
+    // [{"date":"2019-03-01","close":174.97,"volume":25886167,"change":1.82,"changePercent":1.0511,"changeOverTime":0}, ...]
+    auto& buffer = res->body;
+
+    std::string date_key  = "\"date\":\"";
+    std::string close_key = "\"close\":";
+
+    size_t first = 0;
+    while ((first = buffer.find('{', first)) != std::string::npos) {
+        auto last = buffer.find('}', first);
+
+        if (last == std::string::npos) {
+            break;
+        }
+
+        auto date_pos  = buffer.find(date_key, first);
+        auto close_pos = buffer.find(close_key, first);
+
+        if (date_pos < last && close_pos < last) {
+            auto day   = budget::day_number(budget::from_string(buffer.substr(date_pos + date_key.size(), 10)));
+            auto close = std::strtod(buffer.c_str() + close_pos + close_key.size(), nullptr);
+
+            // The entries are sorted by date
+            if (series.days.empty() || series.days.back() < day) {
+                series.days.push_back(day);
+                series.closes.push_back(close);
+            }
+        }
+
+        first = last;
+    }
+
+    if (series.days.empty()) {
+        std::cout << "ERROR: Price(v1): Error parsing share price history" << std::endl;
+        std::cout << "ERROR: Price(v1): URL is " << api_complete << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
 } // end of anonymous namespace
 
+void budget::backfill_share_price_history(const std::string& ticker, budget::date from){
+    auto first = day_number(get_valid_date(from));
+    auto last  = day_number(get_valid_date(budget::local_day()));
+
+    {
+        std::lock_guard<std::mutex> lock(share_prices_lock);
+
+        auto& series = get_price_series(ticker);
+
+        if (series.covers(first) && series.covers(last)) {
+            return;
+        }
+
+        // Only try once per trading day, the history may simply not be available
+        if (series.backfilled == last) {
+            return;
+        }
+
+        series.backfilled = last;
+
+        // Never fetch less than what we already have
+        if (!series.days.empty()) {
+            first = std::min<long>(first, series.days.front());
+        }
+    }
+
+    // The lock is not held during the request
+    price_series fetched;
+    if (!get_share_price_history_v1(ticker, from_day_number(first), fetched)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(share_prices_lock);
+
+    auto& series = get_price_series(ticker);
+
+    // Merge the new prices with the ones we already have
+    std::map<int32_t, double> merged;
+
+    for (size_t i = 0; i < series.days.size(); ++i) {
+        merged[series.days[i]] = series.closes[i];
+    }
+
+    for (size_t i = 0; i < fetched.days.size(); ++i) {
+        merged[fetched.days[i]] = fetched.closes[i];
+    }
+
+    series.days.clear();
+    series.closes.clear();
+
+    for (auto& entry : merged) {
+        series.days.push_back(entry.first);
+        series.closes.push_back(entry.second);
+    }
+
+    save_price_series(ticker, series);
+
+    budget::bump_generation("share_prices");
+
+    if (budget::is_server_running()) {
+        std::cout << "INFO: Share: History of " << ticker << " has been backfilled from "
+                  << from_day_number(series.days.front()) << " (" << series.days.size() << " prices)" << std::endl;
+    }
+}
+
 void budget::load_share_price_cache(){
     std::string file_path = budget::path_to_budget_file("share_price.cache");
     std::ifstream file(file_path);
@@ -137,18 +474,30 @@ void budget::load_share_price_cache(){
         return;
     }
 
+    std::lock_guard<std::mutex> lock(share_prices_lock);
+
     std::string line;
     while (file.good() && getline(file, line)) {
         if (line.empty()) {
             continue;
         }
 
-        auto parts = split(line, ':');
+        // date:ticker:price
+        auto first  = line.find(':');
+        auto second = first == std::string::npos ? first : line.find(':', first + 1);
 
-        share_price_cache_key key(budget::from_string(parts[0]), parts[1]);
-        share_prices[key] = budget::to_number<double>(parts[2]);
+        if (second == std::string::npos) {
+            continue;
+        }
+
+        share_price_cache_key key(budget::from_string(line.substr(0, first)), line.substr(first + 1, second - first - 1));
+        share_prices[key] = budget::parse_double(line.data() + second + 1, line.data() + line.size());
+
+        ++share_prices_log_lines;
     }
 
+    budget::bump_generation("share_prices");
+
     if (budget::is_server_running()) {
         std::cout << "INFO: Share Price Cache has been loaded from " << file_path << std::endl;
         std::cout << "INFO: Share Price Cache has " << share_prices.size() << " entries " << std::endl;
@@ -156,68 +505,156 @@ void budget::load_share_price_cache(){
 }
 
 void budget::save_share_price_cache() {
-    std::string file_path = budget::path_to_budget_file("share_price.cache");
-    std::ofstream file(file_path);
+    std::lock_guard<std::mutex> lock(share_prices_lock);
 
-    if (!file.is_open() || !file.good()){
-        std::cout << "INFO: Impossible to save Share Price Cache" << std::endl;
+    size_t valid = 0;
+    for (auto & pair : share_prices) {
+        if (pair.second != 1.0) {
+            ++valid;
+        }
+    }
+
+    // Every entry is already in the log, only rewrite it when it has superseded lines
+    if (share_prices_log_lines == valid) {
         return;
     }
 
-    for (auto & pair : share_prices) {
-        if (pair.second != 1.0) {
-            auto& key = pair.first;
+    std::string file_path = budget::path_to_budget_file("share_price.cache");
+    std::string tmp_path  = file_path + ".tmp";
+
+    {
+        std::ofstream file(tmp_path);
+
+        if (!file.is_open() || !file.good()){
+            std::cout << "INFO: Impossible to save Share Price Cache" << std::endl;
+            return;
+        }
+
+        file.imbue(std::locale::classic());
 
-            file << budget::date_to_string(key.date) << ':' << key.ticker << ':' << pair.second << std::endl;
+        for (auto & pair : share_prices) {
+            if (pair.second != 1.0) {
+                write_cache_entry(file, pair.first, pair.second);
+            }
         }
     }
 
+    std::rename(tmp_path.c_str(), file_path.c_str());
+
     if (budget::is_server_running()) {
-        std::cout << "INFO: Share Price Cache has been saved to " << file_path << std::endl;
-        std::cout << "INFO: Share Price Cache has " << share_prices.size() << " entries " << std::endl;
+        std::cout << "INFO: Share Price Cache has been compacted from " << share_prices_log_lines << " to " << valid << " lines" << std::endl;
     }
+
+    share_prices_log_lines = valid;
 }
 
 void budget::refresh_share_price_cache(){
+    std::vector<share_price_cache_key> keys;
+
+    {
+        std::lock_guard<std::mutex> lock(share_prices_lock);
+
+        for (auto& pair : share_prices) {
+            keys.push_back(pair.first);
+        }
+    }
+
     // Refresh the prices for each value
-    for (auto& pair : share_prices) {
-        auto& key = pair.first;
+    for (auto& key : keys) {
+        auto price = get_share_price_v1(key.ticker, key.date);
+
+        std::lock_guard<std::mutex> lock(share_prices_lock);
 
-        share_prices[key] = get_share_price_v1(key.ticker, key.date);
+        if (price != share_prices[key]) {
+            share_prices[key] = price;
+
+            budget::bump_generation("share_prices");
+
+            if (price != 1.0) {
+                append_cache_entry(key, price);
+            }
+        }
     }
 
     // Prefetch the current prices
-    for (auto & pair : share_prices) {
-        auto& key = pair.first;
-
+    for (auto& key : keys) {
         share_price(key.ticker);
     }
 
     if (budget::is_server_running()) {
         std::cout << "INFO: Share Price Cache has been refreshed" << std::endl;
-        std::cout << "INFO: Share Price Cache has " << share_prices.size() << " entries " << std::endl;
+        std::cout << "INFO: Share Price Cache has " << keys.size() << " entries " << std::endl;
     }
 }
 
+void budget::schedule_share_jobs(){
+    using namespace std::chrono_literals;
+
+    // The cache is appended on each fetch, it only needs to be compacted once per day
+    budget::schedule_job("share_price_compaction", 24h, save_share_price_cache, 24h, 10min);
+}
+
 double budget::share_price(const std::string& ticker){
     return share_price(ticker, budget::local_day());
 }
 
 double budget::share_price(const std::string& ticker, budget::date d){
+    // Registered once, the cache hits do not take the lock of the metrics
+    static auto& hits   = budget::register_counter("budget_share_price_cache_hits_total");
+    static auto& misses = budget::register_counter("budget_share_price_cache_misses_total");
+
     auto date = get_valid_date(d);
 
     share_price_cache_key key(date, ticker);
 
-    if (!share_prices.count(key)) {
-        auto price = get_share_price_v1(ticker, date);
+    double price;
+    if (cached_share_price(key, price)) {
+        hits.increment();
+        return price;
+    }
+
+    misses.increment();
+
+    // Past prices are taken from the history of the ticker
+    if (date < get_valid_date(budget::local_day())) {
+        auto day = day_number(date);
+
+        bool covered;
+        {
+            std::lock_guard<std::mutex> lock(share_prices_lock);
+            covered = get_price_series(ticker).covers(day);
+        }
 
-        if (budget::is_server_running()) {
-            std::cout << "INFO: Share: Price (" << date << ")"
-                      << " ticker " << ticker << " = " << price << std::endl;
+        if (!covered) {
+            backfill_share_price_history(ticker, date);
         }
 
-        share_prices[key] = price;
+        std::lock_guard<std::mutex> lock(share_prices_lock);
+
+        auto& series = get_price_series(ticker);
+
+        if (series.covers(day)) {
+            return series.price(day);
+        }
+    }
+
+    // The lock is not held during the request
+    price = get_share_price_v1(ticker, date);
+
+    if (budget::is_server_running()) {
+        std::cout << "INFO: Share: Price (" << date << ")"
+                  << " ticker " << ticker << " = " << price << std::endl;
+    }
+
+    std::lock_guard<std::mutex> lock(share_prices_lock);
+
+    share_prices[key] = price;
+
+    budget::bump_generation("share_prices");
+
+    if (price != 1.0) {
+        append_cache_entry(key, price);
     }
 
-    return share_prices[key];
+    return price;
 }
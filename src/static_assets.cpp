@@ -0,0 +1,304 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+
+#include "static_assets.hpp"
+#include "compression.hpp"
+#include "config.hpp"
+#include "utils.hpp"
+#include "http.hpp"
+
+namespace {
+
+struct static_asset {
+    std::string hash;
+    std::string content_type;
+    std::string body;
+    std::string gzip_body; ///< Empty if the asset is not worth compressing
+};
+
+// The libraries used by the pages, with their integrity on cdnjs
+struct library_file {
+    const char* path;
+    const char* integrity;
+};
+
+const library_file library_files[] = {
+    {"jquery/3.3.1/jquery.slim.min.js", "sha256-3edrmyuQ0w65f8gfBsqowzjJe2iM6n0nKciPUp8y+7E="},
+    {"popper.js/1.13.0/umd/popper.min.js", "sha256-pS96pU17yq+gVu4KBQJi38VpSuKN7otMrDQprzf/DWY="},
+    {"twitter-bootstrap/4.0.0-beta.3/css/bootstrap.min.css", "sha256-PCsx7lOyGhyGmzsO5MGXhzwV6UpNTlNf1p6V6w2CppQ="},
+    {"twitter-bootstrap/4.0.0-beta.3/js/bootstrap.min.js", "sha256-JNyuT3QsYBdyeKxKBwnGJAJiACWcow2TjhNruIFFPMQ="},
+    {"open-iconic/1.1.1/font/css/open-iconic-bootstrap.min.css", "sha256-BJ/G+e+y7bQdrYkS2RBTyNfBHpA9IuGaPmf9htub5MQ="},
+    {"open-iconic/1.1.1/font/fonts/open-iconic.eot", ""},
+    {"open-iconic/1.1.1/font/fonts/open-iconic.otf", ""},
+    {"open-iconic/1.1.1/font/fonts/open-iconic.svg", ""},
+    {"open-iconic/1.1.1/font/fonts/open-iconic.ttf", ""},
+    {"open-iconic/1.1.1/font/fonts/open-iconic.woff", ""},
+    {"datatables/1.10.16/css/dataTables.bootstrap4.min.css", "sha256-LpykTdjMm+jVLpDWiYOkH8bYiithb4gajMYnIngj128="},
+    {"datatables/1.10.16/js/jquery.dataTables.min.js", "sha256-qcV1wr+bn4NoBtxYqghmy1WIBvxeoe8vQlCowLG+cng="},
+    {"datatables/1.10.16/js/dataTables.bootstrap4.min.js", "sha256-PahDJkda1lmviWgqffy4CcrECIFPJCWoa9EAqVx7Tf8="},
+    {"highcharts/6.0.4/highstock.js", "sha256-ZdoT00QjMb+DdcNmKfZJYcZY6/H83RYoLS4sZRL43T8="},
+    {"highcharts/6.0.4/highcharts-more.js", "sha256-QnoLQZe7BYRVTl3AY8Lsw6mn60HfHZNpcZBEndybfBk="},
+    {"highcharts/6.0.4/js/modules/solid-gauge.js", "sha256-AIfWX+axQ036B1bKbqeWxklZ4BILxbfcNKDh+sqFS+g="},
+    {"highcharts/6.0.4/js/modules/series-label.js", "sha256-58Ca6fVLKQfXdNwnmkcPq09InNJa/Io8EJPJtKXT70g="},
+};
+
+const char* const budget_css = R"=====(
+body {
+  padding-top: 5rem;
+}
+
+p {
+    margin-bottom: 8px;
+}
+
+.asset_group {
+    margin-left: -20px;
+    margin-right: -20px;
+    padding-left: 5px;
+    border-bottom: 1px solid #343a40;
+    font-weight: bold;
+    color: #343a40;
+}
+
+.asset_row {
+    padding-top: 3px;
+}
+
+.asset_row:not(:last-child) {
+    border-bottom: 1px solid rgba(0,0,0,0.125);
+}
+
+.asset_name {
+    font-weight: bold;
+    color: #007bff;
+    padding-left: 5px;
+}
+
+.asset_right {
+    padding-left: 0px;
+    padding-right: 5px;
+}
+
+.asset_date {
+    color: rgba(0,0,0,0.5);
+}
+
+.small-form-inline {
+    float: left;
+    padding-right: 10px;
+}
+
+.small-text {
+    font-size: 10pt;
+}
+
+.extend-only {
+    width: 75%;
+}
+
+.selector a {
+    font-size: xx-large;
+}
+
+.selector select {
+    vertical-align: middle;
+    margin-bottom: 22px;
+    margin-left: 2px;
+    margin-right: 2px;
+}
+
+.card {
+    margin-bottom: 10px !important;
+}
+
+.card-header-primary {
+    color:white !important;
+    background-color: #007bff !important;
+    padding: 0.5rem 0.75rem !important;
+}
+
+.gauge-cash-flow-title {
+    margin-top: -15px;
+}
+
+.gauge-objective-title {
+    color: rgb(124, 181, 236);
+    margin-top: -15px;
+    text-align: center;
+}
+
+.default-graph-style {
+    min-width: 300px;
+    height: 400px;
+    margin: 0 auto;
+}
+
+.dataTables_wrapper {
+    padding-left: 0px !important;
+    padding-right: 0px !important;
+}
+
+.flat-hr {
+    margin:0px;
+}
+)=====";
+
+// Only modified before the server starts
+std::unordered_map<std::string, static_asset> assets;
+
+bool ends_with(const std::string& value, const std::string& suffix){
+    return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+std::string content_type(const std::string& path){
+    if (ends_with(path, ".css")) {
+        return "text/css";
+    } else if (ends_with(path, ".js")) {
+        return "application/javascript";
+    } else if (ends_with(path, ".svg")) {
+        return "image/svg+xml";
+    } else if (ends_with(path, ".woff")) {
+        return "font/woff";
+    } else if (ends_with(path, ".ttf")) {
+        return "font/ttf";
+    } else if (ends_with(path, ".otf")) {
+        return "font/otf";
+    } else if (ends_with(path, ".eot")) {
+        return "application/vnd.ms-fontobject";
+    }
+
+    return "application/octet-stream";
+}
+
+void add_asset(const std::string& path, std::string&& body){
+    std::stringstream hash;
+    hash << std::hex << std::hash<std::string>()(body);
+
+    auto& asset        = assets[path];
+    asset.hash         = hash.str();
+    asset.content_type = content_type(path);
+    asset.body         = std::move(body);
+
+    // The fonts other than svg are already compressed
+    bool text = ends_with(path, ".css") || ends_with(path, ".js") || ends_with(path, ".svg");
+
+    if (text && asset.body.size() >= budget::compression_threshold) {
+        asset.gzip_body = budget::compress(asset.body, "gzip");
+    }
+}
+
+const library_file* find_library(const std::string& path){
+    for (auto& file : library_files) {
+        if (path == file.path) {
+            return &file;
+        }
+    }
+
+    return nullptr;
+}
+
+} // end of anonymous namespace
+
+void budget::load_static_assets(){
+    add_asset("budget.css", std::string(budget_css));
+
+    auto folder = path_to_budget_file("static");
+
+    size_t local = 0;
+
+    for (auto& file : library_files) {
+        auto path = folder + "/" + file.path;
+
+        if (!file_exists(path)) {
+            continue;
+        }
+
+        std::ifstream stream(path, std::ios::binary);
+        std::stringstream content;
+        content << stream.rdbuf();
+
+        add_asset(file.path, content.str());
+        ++local;
+    }
+
+    std::cout << "INFO: Loaded " << local << " static assets from " << folder << std::endl;
+}
+
+void budget::write_asset_tag(std::ostream& os, const std::string& path){
+    std::string url;
+    std::string integrity;
+
+    auto it = assets.find(path);
+
+    if (it != assets.end()) {
+        url = "/static/" + it->second.hash + "/" + path;
+    } else {
+        url = "https://cdnjs.cloudflare.com/ajax/libs/" + path;
+
+        if (auto* library = find_library(path)) {
+            integrity = library->integrity;
+        }
+    }
+
+    if (ends_with(path, ".css")) {
+        os << R"=====(<link rel="stylesheet" href=")=====" << url << '"';
+    } else {
+        os << R"=====(<script src=")=====" << url << '"';
+    }
+
+    if (!integrity.empty()) {
+        os << R"=====( integrity=")=====" << integrity << R"=====(" crossorigin="anonymous")=====";
+    }
+
+    if (ends_with(path, ".css")) {
+        os << " />";
+    } else {
+        os << "></script>";
+    }
+
+    os << '\n';
+}
+
+void budget::static_asset_page(const httplib::Request& req, httplib::Response& res){
+    auto it = assets.find(req.matches[2].str());
+
+    if (it == assets.end()) {
+        res.status = 404;
+        return;
+    }
+
+    auto& asset = it->second;
+
+    // The stylesheets refer to other assets (fonts) by relative paths, with
+    // the hash of the stylesheet, these must be revalidated
+    if (req.matches[1].str() == asset.hash) {
+        res.set_header("Cache-Control", "public, max-age=31536000, immutable");
+    } else {
+        res.set_header("Cache-Control", "no-cache");
+    }
+
+    auto etag = '"' + asset.hash + '"';
+    res.set_header("ETag", etag.c_str());
+    res.set_header("Vary", "Accept-Encoding");
+
+    if (req.has_header("If-None-Match") && req.get_header_value("If-None-Match") == etag) {
+        res.status = 304;
+        return;
+    }
+
+    if (!asset.gzip_body.empty() && budget::negotiate_encoding(req.get_header_value("Accept-Encoding")) == "gzip") {
+        res.set_header("Content-Encoding", "gzip");
+        res.set_content(asset.gzip_body, asset.content_type.c_str());
+    } else {
+        res.set_content(asset.body, asset.content_type.c_str());
+    }
+}
@@ -0,0 +1,191 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <map>
+#include <queue>
+#include <tuple>
+#include <cctype>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "suggestions.hpp"
+#include "data.hpp"
+#include "expenses.hpp"
+#include "earnings.hpp"
+#include "accounts.hpp"
+
+namespace {
+
+struct trie_node {
+    std::map<char, size_t> children; ///< The index of each child
+    size_t count = 0;                ///< The number of entries with this name
+    size_t best  = 0;                ///< The largest count in the subtree of the node
+    std::string name;                ///< The displayed name, when count is not zero
+};
+
+/*
+ * A prefix tree of the names of a module, in lower case.
+ *
+ * Each node knows the largest count of its subtree, the most used names are
+ * found first, without visiting the other branches.
+ */
+struct name_trie {
+    std::vector<trie_node> nodes{1};
+
+    void add(const std::string& name, long delta){
+        std::vector<size_t> path{0};
+
+        for (char c : name) {
+            char l = std::tolower(static_cast<unsigned char>(c));
+
+            auto& children = nodes[path.back()].children;
+            auto it        = children.find(l);
+
+            if (it == children.end()) {
+                it = children.emplace(l, nodes.size()).first;
+                nodes.emplace_back();
+            }
+
+            path.push_back(it->second);
+        }
+
+        auto& node = nodes[path.back()];
+        node.count += delta;
+
+        if (!node.count) {
+            node.name.clear();
+        } else if (node.name.empty()) {
+            node.name = name;
+        }
+
+        // Only the weights on the path of the name change
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            auto& current = nodes[*it];
+            current.best = current.count;
+
+            for (auto& child : current.children) {
+                current.best = std::max(current.best, nodes[child.second].best);
+            }
+        }
+    }
+
+    std::vector<std::string> complete(const std::string& prefix, size_t limit) const {
+        size_t current = 0;
+
+        for (char c : prefix) {
+            auto& children = nodes[current].children;
+            auto it        = children.find(std::tolower(static_cast<unsigned char>(c)));
+
+            if (it == children.end()) {
+                return {};
+            }
+
+            current = it->second;
+        }
+
+        // (weight, is a name, node), a name is taken before the subtrees of the same weight
+        using item = std::tuple<size_t, bool, size_t>;
+        auto compare = [](const item& lhs, const item& rhs) {
+            return std::get<0>(lhs) != std::get<0>(rhs) ? std::get<0>(lhs) < std::get<0>(rhs)
+                 : std::get<1>(lhs) != std::get<1>(rhs) ? std::get<1>(lhs) < std::get<1>(rhs)
+                 : std::get<2>(lhs) > std::get<2>(rhs);
+        };
+
+        std::priority_queue<item, std::vector<item>, decltype(compare)> queue(compare);
+
+        std::vector<std::string> result;
+
+        if (nodes[current].best) {
+            queue.emplace(nodes[current].best, false, current);
+        }
+
+        while (!queue.empty() && result.size() < limit) {
+            auto top = queue.top();
+            queue.pop();
+
+            auto& node = nodes[std::get<2>(top)];
+
+            if (std::get<1>(top)) {
+                result.push_back(node.name);
+                continue;
+            }
+
+            if (node.count) {
+                queue.emplace(node.count, true, std::get<2>(top));
+            }
+
+            for (auto& child : node.children) {
+                if (nodes[child.second].best) {
+                    queue.emplace(nodes[child.second].best, false, child.second);
+                }
+            }
+        }
+
+        return result;
+    }
+};
+
+struct name_suggestions {
+    name_trie trie;
+    std::unordered_map<size_t, std::string> names; ///< The name of each entry, by id
+};
+
+budget::generation_cache<name_suggestions> expense_suggestions{"expenses"};
+budget::generation_cache<name_suggestions> earning_suggestions{"earnings"};
+budget::generation_cache<name_suggestions> account_suggestions{"accounts"};
+
+// Only the entries added, removed or renamed since the previous generation are updated
+template <typename Data>
+void update_suggestions(name_suggestions& suggestions, const Data& data){
+    std::unordered_set<size_t> present;
+
+    for (auto& entry : data) {
+        present.insert(entry.id);
+
+        auto it = suggestions.names.find(entry.id);
+
+        if (it != suggestions.names.end()) {
+            if (it->second == entry.name) {
+                continue;
+            }
+
+            suggestions.trie.add(it->second, -1);
+        }
+
+        suggestions.trie.add(entry.name, 1);
+        suggestions.names[entry.id] = entry.name;
+    }
+
+    for (auto it = suggestions.names.begin(); it != suggestions.names.end();) {
+        if (!present.count(it->first)) {
+            suggestions.trie.add(it->second, -1);
+            it = suggestions.names.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+template <typename Data>
+std::vector<std::string> suggest(budget::generation_cache<name_suggestions>& cache, const Data& data, const std::string& prefix, size_t limit){
+    return cache.access([&data](name_suggestions& suggestions) { update_suggestions(suggestions, data); },
+                        [&prefix, limit](name_suggestions& suggestions) { return suggestions.trie.complete(prefix, limit); });
+}
+
+} // end of anonymous namespace
+
+std::vector<std::string> budget::suggest_expense_names(const std::string& prefix, size_t limit){
+    return suggest(expense_suggestions, all_expenses(), prefix, limit);
+}
+
+std::vector<std::string> budget::suggest_earning_names(const std::string& prefix, size_t limit){
+    return suggest(earning_suggestions, all_earnings(), prefix, limit);
+}
+
+std::vector<std::string> budget::suggest_account_names(const std::string& prefix, size_t limit){
+    return suggest(account_suggestions, all_accounts(), prefix, limit);
+}
@@ -23,6 +23,7 @@
 #include "config.hpp"
 #include "utils.hpp"
 #include "writer.hpp"
+#include "columns.hpp"
 
 using namespace budget;
 
@@ -218,6 +219,9 @@ void budget::account_summary(budget::writer& w, budget::month month, budget::yea
 
     std::unordered_map<std::string, budget::money> account_previous;
 
+    auto expenses = expenses_columns();
+    auto earnings = earnings_columns();
+
     //Fill the table
 
     budget::money month_tot_expenses;
@@ -239,8 +243,8 @@ void budget::account_summary(budget::writer& w, budget::month month, budget::yea
         budget::month m = i;
 
         for (auto& account : all_accounts(year, m)) {
-            auto total_expenses = accumulate_amount_if(all_expenses(), [account, year, m](const budget::expense& e) { return e.account == account.id && e.date.year() == year && e.date.month() == m; });
-            auto total_earnings = accumulate_amount_if(all_earnings(), [account, year, m](const budget::earning& e) { return e.account == account.id && e.date.year() == year && e.date.month() == m; });
+            auto total_expenses = sum_amounts(*expenses, account.id, column_month(year, m), column_month(year, m));
+            auto total_earnings = sum_amounts(*earnings, account.id, column_month(year, m), column_month(year, m));
 
             auto balance       = account_previous[account.name] + account.amount - total_expenses + total_earnings;
             auto local_balance = account.amount - total_expenses + total_earnings;
@@ -0,0 +1,98 @@
+//=======================================================================
+// Copyright (c) 2013-2018 Baptiste Wicht.
+// Distributed under the terms of the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <iostream>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+
+#include "task_pool.hpp"
+
+namespace {
+
+std::mutex pool_lock;
+std::condition_variable pool_condition;
+
+std::deque<std::function<void()>> tasks;
+std::vector<std::thread> threads;
+bool stopping = false;
+
+void worker_loop(){
+    std::unique_lock<std::mutex> lock(pool_lock);
+
+    while (true) {
+        pool_condition.wait(lock, [](){ return stopping || !tasks.empty(); });
+
+        if (tasks.empty()) {
+            return;
+        }
+
+        auto task = std::move(tasks.front());
+        tasks.pop_front();
+
+        lock.unlock();
+
+        // The exceptions are given to the futures by the packaged tasks
+        task();
+
+        lock.lock();
+    }
+}
+
+} // end of anonymous namespace
+
+void budget::start_task_pool(size_t count){
+    if (!count) {
+        count = std::max(2u, std::thread::hardware_concurrency());
+    }
+
+    std::lock_guard<std::mutex> lock(pool_lock);
+
+    stopping = false;
+
+    for (size_t i = 0; i < count; ++i) {
+        threads.emplace_back(worker_loop);
+    }
+
+    std::cout << "INFO: Task pool: Started " << count << " threads" << std::endl;
+}
+
+void budget::stop_task_pool(){
+    {
+        std::lock_guard<std::mutex> lock(pool_lock);
+        stopping = true;
+    }
+
+    pool_condition.notify_all();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    threads.clear();
+
+    std::cout << "INFO: Task pool: Stopped" << std::endl;
+}
+
+void budget::post_task(std::function<void()> task){
+    {
+        std::unique_lock<std::mutex> lock(pool_lock);
+
+        if (!threads.empty() && !stopping) {
+            tasks.push_back(std::move(task));
+            lock.unlock();
+
+            pool_condition.notify_one();
+            return;
+        }
+    }
+
+    task();
+}
@@ -6,7 +6,12 @@
 //=======================================================================
 
 #include <cstdio>
+#include <cctype>
+#include <cstdint>
 #include <fstream>
+#include <locale>
+#include <sstream>
+#include <algorithm>
 
 #include <unistd.h>
 #ifdef _WIN32
@@ -81,6 +86,81 @@ std::vector<std::string> budget::split(const std::string& s, char delim) {
     return elems;
 }
 
+double budget::parse_double(const char* first, const char* last){
+    const char* begin = first;
+
+    bool negative = false;
+
+    if (first != last && (*first == '-' || *first == '+')) {
+        negative = *first == '-';
+        ++first;
+    }
+
+    // The digits are read as an integer mantissa, the power of ten is applied once
+    uint64_t mantissa = 0;
+    int digits        = 0;
+    int exponent      = 0;
+
+    for (; first != last && std::isdigit(static_cast<unsigned char>(*first)); ++first) {
+        if (mantissa || *first != '0') {
+            mantissa = mantissa * 10 + (*first - '0');
+            ++digits;
+        }
+    }
+
+    if (first != last && (*first == '.' || *first == ',')) {
+        ++first;
+
+        for (; first != last && std::isdigit(static_cast<unsigned char>(*first)); ++first) {
+            if (mantissa || *first != '0') {
+                mantissa = mantissa * 10 + (*first - '0');
+                ++digits;
+            }
+
+            --exponent;
+        }
+    }
+
+    if (first != last && (*first == 'e' || *first == 'E')) {
+        ++first;
+
+        bool negative_exponent = false;
+        if (first != last && (*first == '-' || *first == '+')) {
+            negative_exponent = *first == '-';
+            ++first;
+        }
+
+        int value = 0;
+        for (; first != last && std::isdigit(static_cast<unsigned char>(*first)); ++first) {
+            value = std::min(value * 10 + (*first - '0'), 10000);
+        }
+
+        exponent += negative_exponent ? -value : value;
+    }
+
+    // The mantissa and the power of ten are both exact doubles, so the single
+    // multiplication or division is correctly rounded
+    static constexpr double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    if (digits <= 15 && exponent >= -22 && exponent <= 22) {
+        double value = double(mantissa);
+        value = exponent < 0 ? value / powers[-exponent] : value * powers[exponent];
+        return negative ? -value : value;
+    }
+
+    // The other numbers are rare, they are parsed by the standard library
+    std::string copy(begin, first);
+    std::replace(copy.begin(), copy.end(), ',', '.');
+
+    std::stringstream stream(copy);
+    stream.imbue(std::locale::classic());
+
+    double value = 0.0;
+    stream >> value;
+    return value;
+}
+
 std::string budget::base64_decode(const std::string& in) {
     // table from '+' to 'z'
     const uint8_t lookup[] = {
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+
+#=======================================================================
+# Copyright (c) 2013-2018 Baptiste Wicht.
+# Distributed under the terms of the MIT License.
+# (See accompanying file LICENSE or copy at
+#  http://opensource.org/licenses/MIT)
+#=======================================================================
+
+# Local stand-in for the IEX cloud chart endpoints used by the share prices.
+#
+# It serves deterministic closing prices for any ticker, on week days only:
+#
+#   /<version>/stock/<ticker>/chart/<range>?chartCloseOnly=true
+#   /<version>/stock/<ticker>/chart/date/<YYYY-MM-DD>?chartByDay=true
+#
+# To use it, start it and add to the configuration:
+#
+#   iex_cloud_host=localhost
+#   iex_cloud_port=8123
+#   iex_cloud_token=stub
+
+import argparse
+import datetime
+import json
+import math
+import re
+import zlib
+
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import urlparse
+
+RANGES = {"1m": 30, "3m": 91, "6m": 182, "1y": 365, "2y": 2 * 365, "5y": 5 * 365, "max": 15 * 365}
+
+CHART = re.compile(r"^/[^/]+/stock/([^/]+)/chart/(?:date/(\d{4}-\d{2}-\d{2})|([^/]+))$")
+
+def close_price(ticker, day):
+    """ The closing price of the ticker on the given day, always the same """
+    seed  = zlib.crc32(ticker.encode())
+    base  = 20 + seed % 180
+    phase = (seed >> 8) % 365
+    n     = day.toordinal()
+
+    return round(base * (1 + 0.002 * (n % 3650) / 10 + 0.1 * math.sin((n + phase) / 29.0)), 2)
+
+def trading_days(first, last):
+    day = first
+    while day <= last:
+        if day.weekday() < 5:
+            yield day
+        day += datetime.timedelta(days=1)
+
+def entry(ticker, day):
+    return {"date": day.isoformat(), "close": close_price(ticker, day), "high": 0, "volume": 1000000}
+
+class ChartHandler(BaseHTTPRequestHandler):
+    def do_GET(self):
+        url   = urlparse(self.path)
+        match = CHART.match(url.path)
+
+        if not match:
+            return self.reply(404, {"error": "Unknown endpoint " + url.path})
+
+        ticker, date, range_ = match.groups()
+
+        if date:
+            day = datetime.date.fromisoformat(date)
+            entries = [entry(ticker, day)] if day.weekday() < 5 else []
+        elif range_ in RANGES:
+            last  = datetime.date.today() - datetime.timedelta(days=1)
+            first = last - datetime.timedelta(days=RANGES[range_])
+            entries = [entry(ticker, day) for day in trading_days(first, last)]
+        else:
+            return self.reply(400, {"error": "Unknown range " + range_})
+
+        self.reply(200, entries)
+
+    def reply(self, status, content):
+        body = json.dumps(content, separators=(",", ":")).encode()
+
+        self.send_response(status)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+def main():
+    parser = argparse.ArgumentParser(description="Local stand-in for the IEX cloud chart endpoints")
+    parser.add_argument("--host", default="localhost")
+    parser.add_argument("--port", type=int, default=8123)
+    args = parser.parse_args()
+
+    server = ThreadingHTTPServer((args.host, args.port), ChartHandler)
+    print("INFO: Serving the IEX chart endpoints on http://%s:%d" % (args.host, args.port))
+
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+if __name__ == "__main__":
+    main()